@@ -0,0 +1,242 @@
+;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;
+;;         Distributed under the Boost Software License, Version 1.0.          ;;
+;;            (See accompanying file LICENSE or copy at                        ;;
+;;                 https://www.boost.org/LICENSE_1_0.txt)                      ;;
+;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;
+
+global collision_init
+global find_brick_collision
+
+;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;
+; This file contains routines for testing an entity against many bricks at once.
+;
+; Bricks are passed as four columns of signed 32 bit values (x, y, width and height). Each column must be 32 byte aligned
+; and readable up to the next multiple of 8 bricks, as whole blocks of bricks are loaded at a time.
+;
+; There is an SSE2 implementation (4 bricks per iteration) and an AVX2 implementation (8 bricks per iteration), the
+; best one supported by the CPU is chosen by collision_init.
+
+;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;
+; Select the collision implementation for the current CPU. This should be called before find_brick_collision, if it
+; isn't then the SSE2 implementation is used (which every x86_64 CPU supports).
+;
+collision_init:
+    push rbp
+    mov rbp, rsp
+    push rbx ; cpuid clobbers rbx
+
+    ; check cpuid supports the extended features leaf
+    mov eax, 0x0
+    cpuid
+    cmp eax, 0x7
+    jb collision_init_end
+
+    ; check the CPU supports AVX and the OS supports XSAVE
+    mov eax, 0x1
+    cpuid
+    and ecx, 0x18000000 ; OSXSAVE | AVX
+    cmp ecx, 0x18000000
+    jne collision_init_end
+
+    ; check the OS preserves xmm and ymm registers
+    mov ecx, 0x0
+    xgetbv
+    and eax, 0x6
+    cmp eax, 0x6
+    jne collision_init_end
+
+    ; check the CPU supports AVX2
+    mov eax, 0x7
+    mov ecx, 0x0
+    cpuid
+    test ebx, 0x20
+    jz collision_init_end
+
+    lea rax, [find_brick_collision_avx2]
+    mov [find_brick_collision_impl], rax
+
+collision_init_end:
+    pop rbx
+    pop rbp
+    ret
+
+;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;
+; Find the first brick an entity collides with.
+;
+; @param rdi
+;   Address of entity to test.
+;
+; @param rsi
+;   Address of brick x column.
+;
+; @param rdx
+;   Address of brick y column.
+;
+; @param rcx
+;   Address of brick width column.
+;
+; @param r8
+;   Address of brick height column.
+;
+; @param r9
+;   Number of bricks.
+;
+; @returns
+;   Index of the first brick the entity collides with, or -1 if there is no collision.
+;
+find_brick_collision:
+    jmp [find_brick_collision_impl]
+
+;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;
+; SSE2 implementation of find_brick_collision, see that function for parameters.
+;
+find_brick_collision_sse2:
+    push rbp
+    mov rbp, rsp
+
+    ; broadcast the edges of the entity into every lane
+    mov eax, [rdi]
+    movd xmm4, eax
+    pshufd xmm4, xmm4, 0x0 ; left
+    add eax, [rdi + 16]
+    movd xmm5, eax
+    pshufd xmm5, xmm5, 0x0 ; right
+    mov eax, [rdi + 8]
+    movd xmm6, eax
+    pshufd xmm6, xmm6, 0x0 ; top
+    add eax, [rdi + 24]
+    movd xmm7, eax
+    pshufd xmm7, xmm7, 0x0 ; bottom
+
+    mov r10, 0x0 ; index of first brick in block
+
+sse2_loop_start:
+    cmp r10, r9
+    jae sse2_no_collision
+
+    ; entity left < brick right && entity right > brick left
+    movdqa xmm0, [rsi + r10 * 4]
+    movdqa xmm1, [rcx + r10 * 4]
+    paddd xmm1, xmm0
+    pcmpgtd xmm1, xmm4
+    movdqa xmm2, xmm5
+    pcmpgtd xmm2, xmm0
+    pand xmm1, xmm2
+
+    ; entity top < brick bottom && entity bottom > brick top
+    movdqa xmm0, [rdx + r10 * 4]
+    movdqa xmm2, [r8 + r10 * 4]
+    paddd xmm2, xmm0
+    pcmpgtd xmm2, xmm6
+    pand xmm1, xmm2
+    movdqa xmm2, xmm7
+    pcmpgtd xmm2, xmm0
+    pand xmm1, xmm2
+
+    movmskps eax, xmm1 ; one bit per brick collided with
+
+    ; ignore any lanes past the last brick
+    mov r11, r9
+    sub r11, r10
+    cmp r11, 4
+    jae sse2_mask_end
+    movzx r11d, byte [tail_masks + r11]
+    and eax, r11d
+sse2_mask_end:
+
+    test eax, eax
+    jnz sse2_collision
+
+    add r10, 4
+    jmp sse2_loop_start
+
+sse2_collision:
+    bsf eax, eax ; lowest set bit is the first brick collided with
+    add rax, r10
+    jmp sse2_end
+
+sse2_no_collision:
+    mov rax, -1
+
+sse2_end:
+    pop rbp
+    ret
+
+;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;
+; AVX2 implementation of find_brick_collision, see that function for parameters.
+;
+find_brick_collision_avx2:
+    push rbp
+    mov rbp, rsp
+
+    ; broadcast the edges of the entity into every lane
+    mov eax, [rdi]
+    vmovd xmm4, eax
+    vpbroadcastd ymm4, xmm4 ; left
+    add eax, [rdi + 16]
+    vmovd xmm5, eax
+    vpbroadcastd ymm5, xmm5 ; right
+    mov eax, [rdi + 8]
+    vmovd xmm6, eax
+    vpbroadcastd ymm6, xmm6 ; top
+    add eax, [rdi + 24]
+    vmovd xmm7, eax
+    vpbroadcastd ymm7, xmm7 ; bottom
+
+    mov r10, 0x0 ; index of first brick in block
+
+avx2_loop_start:
+    cmp r10, r9
+    jae avx2_no_collision
+
+    ; entity left < brick right && entity right > brick left
+    vmovdqa ymm0, [rsi + r10 * 4]
+    vpaddd ymm1, ymm0, [rcx + r10 * 4]
+    vpcmpgtd ymm1, ymm1, ymm4
+    vpcmpgtd ymm2, ymm5, ymm0
+    vpand ymm1, ymm1, ymm2
+
+    ; entity top < brick bottom && entity bottom > brick top
+    vmovdqa ymm0, [rdx + r10 * 4]
+    vpaddd ymm2, ymm0, [r8 + r10 * 4]
+    vpcmpgtd ymm2, ymm2, ymm6
+    vpand ymm1, ymm1, ymm2
+    vpcmpgtd ymm2, ymm7, ymm0
+    vpand ymm1, ymm1, ymm2
+
+    vmovmskps eax, ymm1 ; one bit per brick collided with
+
+    ; ignore any lanes past the last brick
+    mov r11, r9
+    sub r11, r10
+    cmp r11, 8
+    jae avx2_mask_end
+    movzx r11d, byte [tail_masks + r11]
+    and eax, r11d
+avx2_mask_end:
+
+    test eax, eax
+    jnz avx2_collision
+
+    add r10, 8
+    jmp avx2_loop_start
+
+avx2_collision:
+    bsf eax, eax ; lowest set bit is the first brick collided with
+    add rax, r10
+    jmp avx2_end
+
+avx2_no_collision:
+    mov rax, -1
+
+avx2_end:
+    vzeroupper ; avoid AVX-SSE transition penalties in the caller
+    pop rbp
+    ret
+
+section .data
+    find_brick_collision_impl: dq find_brick_collision_sse2
+
+section .rodata
+    ; masks with the lowest n bits set, used to discard lanes past the last brick
+    tail_masks: db 0x0, 0x1, 0x3, 0x7, 0xf, 0x1f, 0x3f, 0x7f
@@ -4,25 +4,40 @@
 ;;                 https://www.boost.org/LICENSE_1_0.txt)                      ;;
 ;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;
 
+global clear_rectangle
 global create_window
 global try_get_event
+global wait_for_event
 
+extern XAllocColor
 extern XBlackPixel
-extern XCheckWindowEvent
+extern XClearArea
 extern XClearWindow
+extern XConnectionNumber
 extern XCreateGC
 extern XCreateSimpleWindow
+extern XDefaultColormap
+extern XDefaultDepth
 extern XDefaultRootWindow
 extern XDefaultScreen
+extern XDefaultVisual
+extern XDestroyImage
 extern XFillRectangle
 extern XFlush
+extern XIfEvent
 extern XLookupKeysym
 extern XMapWindow
 extern XNextEvent
 extern XSync
 extern XOpenDisplay
+extern XPending
 extern XSelectInput
 extern XSetForeground
+extern XShmAttach
+extern XShmCreateImage
+extern XShmGetEventBase
+extern XShmPutImage
+extern XShmQueryExtension
 extern XWhitePixel
 
 extern assert_not_null
@@ -35,7 +50,19 @@ extern print_num
 
 ;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;
 ; This file contains functions for creating a window and rendering to it.
+;
+; If the X server supports the MIT-SHM extension then rendering is done in software, rectangles are filled directly into
+; an image in memory shared with the server and the whole frame is presented with a single XShmPutImage. Otherwise each
+; rectangle is drawn with X protocol requests.
+;
+; The server reads the shared image asynchronously after XShmPutImage, so rather than a round trip every frame we ask
+; for a ShmCompletion event and only wait for it (in shm_wait_idle) before next writing to the image.
+;
+; The window is not cleared each frame, callers clear just the regions that have changed with clear_rectangle and only
+; call render_begin when the whole frame needs redrawing.
 
+WINDOW_SIZE equ 0x320 ; width and height of window
+COLOUR_CACHE_SIZE equ 0x10 ; number of resolved colours to remember
 
 ;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;
 ; Create and display an X Window.
@@ -66,6 +93,11 @@ create_window:
     call XBlackPixel
     mov [black_colour], rax
 
+    mov rdi, [display]
+    mov rsi, [screen_number]
+    call XDefaultColormap
+    mov [colormap], rax
+
     mov rdi, [display]
     call XDefaultRootWindow
     mov [default_root_window], rax
@@ -74,8 +106,8 @@ create_window:
     mov rsi, [default_root_window]
     mov rdx, 0x0
     mov rcx, 0x0
-    mov r8, 0x320
-    mov r9, 0x320
+    mov r8, WINDOW_SIZE
+    mov r9, WINDOW_SIZE
     mov rax, [black_colour]
     push rax
     push rax
@@ -86,7 +118,7 @@ create_window:
 
     mov rdi, [display]
     mov rsi, [window]
-    mov rdx, 0x20003
+    mov rdx, 0x28003 ; KeyPress | KeyRelease | Exposure | StructureNotify
     call XSelectInput
 
     mov rdi, [display]
@@ -100,6 +132,8 @@ create_window:
     call XCreateGC
     mov [gc], rax
 
+    call shm_init
+
     ; wait until window has appeared
 wait_loop_start:
     mov rdi, [display]
@@ -117,7 +151,123 @@ wait_loop_end:
     ret
 
 ;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;
-; Try and get an event
+; Try and create a shared memory image to render into. If the MIT-SHM extension is unavailable (e.g. a remote display)
+; then shm_enabled is left as 0x0 and rendering falls back to X protocol requests.
+;
+shm_init:
+    push rbp
+    mov rbp, rsp
+
+    mov rdi, [display]
+    call XShmQueryExtension
+    cmp rax, 0x0
+    je shm_init_end
+
+    mov rdi, [display]
+    mov rsi, [screen_number]
+    call XDefaultVisual
+    mov [visual], rax
+
+    mov rdi, [display]
+    mov rsi, [screen_number]
+    call XDefaultDepth
+
+    ; create an image with no data, the shared memory is attached below
+    mov rdi, [display]
+    mov rsi, [visual]
+    mov rdx, rax ; depth
+    mov rcx, 0x2 ; ZPixmap
+    mov r8, 0x0
+    lea r9, [shm_info]
+    push WINDOW_SIZE ; height
+    push WINDOW_SIZE ; width
+    call XShmCreateImage
+    add rsp, 0x10
+
+    cmp rax, 0x0
+    je shm_init_end
+    mov [shm_image], rax
+
+    ; rendering writes whole 32 bit pixels, so any other pixel size falls back to X requests
+    mov eax, [rax + 48] ; bits_per_pixel
+    cmp rax, 0x20
+    jne shm_init_destroy_image
+
+    ; shmget syscall, allocate bytes_per_line * height
+    mov rax, [shm_image]
+    movsxd rsi, dword [rax + 44] ; bytes_per_line
+    movsxd rcx, dword [rax + 4] ; height
+    imul rsi, rcx
+    mov rax, 0x1d
+    mov rdi, 0x0 ; IPC_PRIVATE
+    mov rdx, 0x380 ; IPC_CREAT | 0600
+    syscall
+
+    cmp rax, 0x0
+    jl shm_init_destroy_image
+    mov [shm_info + 8], eax ; shmid
+
+    ; shmat syscall, map the segment into our address space
+    mov rdi, rax
+    mov rax, 0x1e
+    mov rsi, 0x0
+    mov rdx, 0x0
+    syscall
+
+    cmp rax, 0x0
+    jl shm_init_remove_segment
+    mov [shm_info + 16], rax ; shmaddr
+    mov rcx, [shm_image]
+    mov [rcx + 16], rax ; image data
+    mov dword [shm_info + 24], 0x0 ; readOnly
+
+    mov rdi, [display]
+    lea rsi, [shm_info]
+    call XShmAttach
+
+    ; wait for the server to attach before marking the segment for removal, it is then freed once both sides detach
+    mov rdi, [display]
+    mov rsi, 0x0
+    call XSync
+
+    ; shmctl syscall with IPC_RMID
+    mov rax, 0x1f
+    mov edi, [shm_info + 8]
+    mov rsi, 0x0
+    mov rdx, 0x0
+    syscall
+
+    ; completion events are the first event of the extension
+    mov rdi, [display]
+    call XShmGetEventBase
+    movsxd rax, eax
+    mov [shm_completion_type], rax
+
+    mov rax, 0x1
+    mov [shm_enabled], rax
+    jmp shm_init_end
+
+shm_init_remove_segment:
+    ; shmctl syscall with IPC_RMID, nothing is attached so the segment is freed immediately
+    mov rax, 0x1f
+    mov edi, [shm_info + 8]
+    mov rsi, 0x0
+    mov rdx, 0x0
+    syscall
+
+shm_init_destroy_image:
+    ; the image owns no data yet, so this only frees the XImage itself
+    mov rdi, [shm_image]
+    call XDestroyImage
+    mov rax, 0x0
+    mov [shm_image], rax
+
+shm_init_end:
+    pop rbp
+    ret
+
+;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;
+; Try and get an event, without blocking. Call until it returns 0x0 to drain all pending events.
 ;
 ; @returns
 ;   Address of an event, or 0x0 if no event was available.
@@ -126,16 +276,26 @@ try_get_event:
     push rbp
     mov rbp, rsp
 
-    ; see if we want have events
+    ; see if we have events (this also reads anything the server has sent without blocking)
     mov rdi, [display]
-    mov rsi, [window]
-    mov rdx, 0x03
-    lea rcx, [event]
-    call XCheckWindowEvent
+    call XPending
 
     cmp rax, 0x0
     je try_get_event_end
 
+    mov rdi, [display]
+    lea rsi, [event]
+    call XNextEvent
+
+    ; a completion event means the server has finished reading the shared image, so it is free to write to again
+    mov eax, [event]
+    cmp rax, [shm_completion_type]
+    jne try_get_event_found
+
+    mov rax, 0x0
+    mov [shm_pending], rax
+
+try_get_event_found:
     ; we got an event so return pointer to event object
     lea rax, [event]
 
@@ -143,16 +303,86 @@ try_get_event_end:
     pop rbp
     ret
 
-; Perform pre-render tasks
+;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;
+; Block until an event is available or a timeout expires, whichever is first.
+;
+; @param rdi
+;   Maximum number of nanoseconds to wait.
+;
+wait_for_event:
+    push rbp
+    mov rbp, rsp
+    push rdi
+    sub rsp, 0x18 ; space for a struct pollfd and a struct timespec
+
+    ; events may already be queued by Xlib, in which case the connection won't be readable
+    mov rdi, [display]
+    call XPending
+
+    cmp rax, 0x0
+    jne wait_for_event_end
+
+    mov rdi, [display]
+    call XConnectionNumber
+
+    ; fill in struct pollfd
+    mov [rsp], eax ; fd
+    mov word [rsp + 4], 0x1 ; events = POLLIN
+    mov word [rsp + 6], 0x0 ; revents
+
+    ; fill in struct timespec
+    mov rax, [rsp + 24] ; timeout
+    mov rdx, 0x0
+    mov rcx, 1000000000
+    div rcx
+    mov [rsp + 8], rax ; tv_sec
+    mov [rsp + 16], rdx ; tv_nsec
+
+    ; ppoll syscall
+    mov rax, 0x10f
+    mov rdi, rsp
+    mov rsi, 0x1
+    lea rdx, [rsp + 8]
+    mov r10, 0x0 ; leave signal mask alone
+    mov r8, 0x8
+    syscall
+
+wait_for_event_end:
+    add rsp, 0x20
+    pop rbp
+    ret
+
+;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;
+; Clear the whole window, for when every entity is about to be redrawn.
+;
 render_begin:
     push rbp
     mov rbp, rsp
 
+    mov rax, [shm_enabled]
+    cmp rax, 0x0
+    jne render_begin_shm
+
     ; clear window
     mov rdi, [display]
     mov rsi, [window]
     call XClearWindow
-
+    jmp render_begin_end
+
+render_begin_shm:
+    call shm_wait_idle
+
+    ; clear every pixel in the image
+    mov rdx, [shm_image]
+    mov rdi, [rdx + 16] ; image data
+    movsxd rcx, dword [rdx + 44] ; bytes_per_line
+    movsxd rax, dword [rdx + 4] ; height
+    imul rcx, rax
+    shr rcx, 2 ; number of pixels
+    mov eax, [black_colour]
+    rep stosd
+
+render_begin_end:
     pop rbp
     ret
 
@@ -171,6 +401,9 @@ render_begin:
 ; @param rcx
 ;   Height of rectangle
 ;
+; @param r8
+;   Colour of rectangle, as 0xRRGGBB.
+;
 draw_rectangle:
     push rbp
     mov rbp, rsp
@@ -181,13 +414,25 @@ draw_rectangle:
     push rsi
     push rdi
 
-    ; set foreground color for drawing
+    mov rdi, r8
+    call colour_to_pixel
+    mov r8, rax
+
+    mov rax, [shm_enabled]
+    cmp rax, 0x0
+    jne draw_rectangle_shm
+
+    ; only set the foreground colour if it has changed since the last rectangle
+    cmp r8, [current_foreground]
+    je draw_rectangle_fill
+
+    mov [current_foreground], r8
     mov rdi, [display]
     mov rsi, [gc]
-    mov rdx, [white_colour]
+    mov rdx, r8
     call XSetForeground
 
-    ; draw paddle
+draw_rectangle_fill:
     mov rdi, [display]
     mov rsi, [window]
     mov rdx, [gc]
@@ -196,6 +441,284 @@ draw_rectangle:
     pop r9 ; note that the last arg is now at at the top of the stack
     call XFillRectangle
     add rsp, 0x8
+    jmp draw_rectangle_end
+
+draw_rectangle_shm:
+    pop rdi
+    pop rsi
+    pop rdx
+    pop rcx
+    call shm_fill_rectangle
+
+draw_rectangle_end:
+    pop rbp
+    ret
+
+;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;
+; Convert a colour to a pixel value for the window's colormap. Colours are resolved with XAllocColor the first time
+; they are seen and then cached.
+;
+; @param rdi
+;   Colour, as 0xRRGGBB.
+;
+; @returns
+;   Pixel value.
+;
+colour_to_pixel:
+    push rbp
+    mov rbp, rsp
+    sub rsp, 0x20 ; space for an XColor and the colour being resolved
+
+    ; see if we have already resolved this colour
+    mov rcx, 0x0
+colour_cache_search_start:
+    cmp rcx, [colour_cache_count]
+    je colour_cache_miss
+
+    cmp rdi, [colour_cache_rgb + rcx * 8]
+    je colour_cache_hit
+
+    inc rcx
+    jmp colour_cache_search_start
+
+colour_cache_hit:
+    mov rax, [colour_cache_pixel + rcx * 8]
+    jmp colour_to_pixel_end
+
+colour_cache_miss:
+    mov [rsp + 16], rdi
+
+    ; fill in XColor, which has 16 bit channels so scale each 8 bit channel by 257 (0xff -> 0xffff)
+    mov rax, rdi
+    shr rax, 16
+    and eax, 0xff
+    imul eax, eax, 257
+    mov [rsp + 8], ax ; red
+
+    mov rax, rdi
+    shr rax, 8
+    and eax, 0xff
+    imul eax, eax, 257
+    mov [rsp + 10], ax ; green
+
+    mov rax, rdi
+    and eax, 0xff
+    imul eax, eax, 257
+    mov [rsp + 12], ax ; blue
+
+    mov byte [rsp + 14], 0x7 ; DoRed | DoGreen | DoBlue
+
+    mov rdi, [display]
+    mov rsi, [colormap]
+    mov rdx, rsp
+    call XAllocColor
+
+    ; if the colour couldn't be allocated then fall back to white
+    cmp rax, 0x0
+    jne colour_cache_insert
+
+    mov rax, [white_colour]
+    jmp colour_to_pixel_end
+
+colour_cache_insert:
+    mov rax, [rsp] ; pixel
+
+    ; remember the pixel, if there is room
+    mov rcx, [colour_cache_count]
+    cmp rcx, COLOUR_CACHE_SIZE
+    je colour_to_pixel_end
+
+    mov rdx, [rsp + 16]
+    mov [colour_cache_rgb + rcx * 8], rdx
+    mov [colour_cache_pixel + rcx * 8], rax
+    inc rcx
+    mov [colour_cache_count], rcx
+
+colour_to_pixel_end:
+    leave
+    ret
+
+;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;
+; Clear a rectangle to the background colour.
+;
+; @param rdi
+;   X coord of rectangle
+;
+; @param rsi
+;   Y coord of rectangle
+;
+; @param rdx
+;   Width of rectangle
+;
+; @param rcx
+;   Height of rectangle
+;
+clear_rectangle:
+    push rbp
+    mov rbp, rsp
+
+    mov rax, [shm_enabled]
+    cmp rax, 0x0
+    jne clear_rectangle_shm
+
+    ; XClearArea treats a zero width or height as "to the edge of the window", so skip empty rectangles
+    cmp rdx, 0x0
+    jle clear_rectangle_end
+    cmp rcx, 0x0
+    jle clear_rectangle_end
+
+    mov r8, rdx
+    mov r9, rcx
+    mov rdx, rdi
+    mov rcx, rsi
+    mov rdi, [display]
+    mov rsi, [window]
+    sub rsp, 0x8 ; keep stack aligned
+    push 0x0 ; don't generate exposure events
+    call XClearArea
+    add rsp, 0x10
+    jmp clear_rectangle_end
+
+clear_rectangle_shm:
+    mov r8, [black_colour]
+    call shm_fill_rectangle
+
+clear_rectangle_end:
+    pop rbp
+    ret
+
+;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;
+; Fill a rectangle in the shared memory image, clipped to the image.
+;
+; @param rdi
+;   X coord of rectangle
+;
+; @param rsi
+;   Y coord of rectangle
+;
+; @param rdx
+;   Width of rectangle
+;
+; @param rcx
+;   Height of rectangle
+;
+; @param r8
+;   Pixel value to fill with.
+;
+shm_fill_rectangle:
+    push rbp
+    mov rbp, rsp
+    call shm_wait_idle
+    push r8
+
+    ; convert to edges
+    lea r8, [rdi + rdx] ; right
+    lea r9, [rsi + rcx] ; bottom
+
+    ; clip to image
+    mov rax, 0x0
+    cmp rdi, rax
+    cmovl rdi, rax
+    cmp rsi, rax
+    cmovl rsi, rax
+
+    mov rdx, [shm_image]
+    movsxd rax, dword [rdx] ; width
+    cmp r8, rax
+    cmovg r8, rax
+    movsxd rax, dword [rdx + 4] ; height
+    cmp r9, rax
+    cmovg r9, rax
+
+    ; nothing to fill if rectangle is entirely outside image
+    cmp rdi, r8
+    jge shm_fill_rectangle_end
+    cmp rsi, r9
+    jge shm_fill_rectangle_end
+
+    sub r8, rdi ; pixels per row
+    sub r9, rsi ; number of rows
+
+    ; get address of top left pixel
+    movsxd r10, dword [rdx + 44] ; bytes_per_line
+    mov r11, [rdx + 16] ; image data
+    imul rsi, r10
+    add r11, rsi
+    lea r11, [r11 + rdi * 4]
+
+    mov eax, [rbp - 8] ; pixel value
+
+shm_fill_row_start:
+    ; fill row
+    mov rdi, r11
+    mov rcx, r8
+    rep stosd
+
+    add r11, r10
+    dec r9
+    jnz shm_fill_row_start
+
+shm_fill_rectangle_end:
+    leave
+    ret
+
+;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;
+; Block until the server has finished reading the shared image from the last XShmPutImage, if it hasn't already. This
+; preserves rdi, rsi, rdx, rcx and r8 so it can be called at the start of any function which writes to the image.
+;
+shm_wait_idle:
+    push rbp
+    mov rbp, rsp
+
+    mov rax, [shm_pending]
+    cmp rax, 0x0
+    je shm_wait_idle_end
+
+    push rdi
+    push rsi
+    push rdx
+    push rcx
+    push r8
+    sub rsp, 0x8 ; keep stack aligned
+
+    ; wait for the completion event, leaving any other events queued for try_get_event
+    mov rdi, [display]
+    lea rsi, [shm_event]
+    lea rdx, [shm_is_completion]
+    mov rcx, 0x0
+    call XIfEvent
+
+    mov rax, 0x0
+    mov [shm_pending], rax
+
+    add rsp, 0x8
+    pop r8
+    pop rcx
+    pop rdx
+    pop rsi
+    pop rdi
+
+shm_wait_idle_end:
+    pop rbp
+    ret
+
+;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;
+; XIfEvent predicate matching completion events.
+;
+; @param rsi
+;   Address of event to check.
+;
+; @returns
+;   0x1 if the event is a completion event, otherwise 0x0.
+;
+shm_is_completion:
+    push rbp
+    mov rbp, rsp
+
+    mov eax, [rsi]
+    cmp rax, [shm_completion_type]
+    mov rax, 0x0
+    sete al
 
     pop rbp
     ret
@@ -207,10 +730,40 @@ render_end:
     push rbp
     mov rbp, rsp
 
+    mov rax, [shm_enabled]
+    cmp rax, 0x0
+    jne render_end_shm
+
     ; ensure all draw commands are flushed
     mov rdi, [display]
     call XFlush
+    jmp render_end_end
+
+render_end_shm:
+    ; present whole image
+    mov rdi, [display]
+    mov rsi, [window]
+    mov rdx, [gc]
+    mov rcx, [shm_image]
+    mov r8, 0x0 ; src_x
+    mov r9, 0x0 ; src_y
+    sub rsp, 0x8 ; keep stack aligned
+    push 0x1 ; send_event, so we get a completion event
+    push WINDOW_SIZE ; height
+    push WINDOW_SIZE ; width
+    push 0x0 ; dst_y
+    push 0x0 ; dst_x
+    call XShmPutImage
+    add rsp, 0x30
+
+    ; don't wait for the server to read the image here, the next write to it waits for the completion event instead
+    mov rax, 0x1
+    mov [shm_pending], rax
+
+    mov rdi, [display]
+    call XFlush
 
+render_end_end:
     pop rbp
     ret
 
@@ -219,10 +772,24 @@ section .data
     screen_number: dq 0x0
     black_colour: dq 0x0
     white_colour: dq 0x0
+    colormap: dq 0x0
+    current_foreground: dq 0xffffffffffffffff ; pixel value the gc is set to, starts as an impossible pixel
+    colour_cache_count: dq 0x0
     default_root_window: dq 0x0
     window: dq 0x0
     gc: dq 0x0
+    visual: dq 0x0
+    shm_enabled: dq 0x0
+    shm_image: dq 0x0
+    shm_completion_type: dq 0x0 ; event type of completion events, 0x0 is never a valid event type
+    shm_pending: dq 0x0 ; 0x1 whilst the server may still be reading the shared image
     event: resb 0xc0
+    shm_event: resb 0xc0 ; completion events waited for by shm_wait_idle
+
+section .bss
+    shm_info: resb 0x20 ; XShmSegmentInfo
+    colour_cache_rgb: resq COLOUR_CACHE_SIZE
+    colour_cache_pixel: resq COLOUR_CACHE_SIZE
 
 section .rodata
     hello_world: db "hello world", 0xa, 0x0
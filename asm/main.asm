@@ -19,47 +19,137 @@ extern XWhitePixel
 
 extern assert_not_null
 extern assert_null
+extern clear_rectangle
+extern collision_init
 extern create_window
 extern draw_rectangle
 extern exit
-extern get_time
-extern linked_list_init
-extern linked_list_iterator
-extern linked_list_iterator_advance
-extern linked_list_iterator_remove
-extern linked_list_iterator_value
-extern linked_list_push_back
-extern memory_malloc
+extern find_brick_collision
+extern get_time_ns
+extern log_flush
 extern print
 extern print_num
 extern render_begin
 extern render_end
-extern sleep_ms
+extern timer_init
 extern try_get_event
+extern wait_for_event
+
+FRAME_TIME_NS equ 30000000 ; target duration of a frame
+RECT_SIZE equ 32 ; size of a rectangle: x, y, width, height (8 bytes each), an entity is a rectangle followed by a colour
+MAX_DIRTY equ 16 ; maximum number of regions that can be redrawn in a frame
+MAX_PALETTE equ 8 ; maximum number of distinct brick colours
+MAX_BRICKS equ 64 ; capacity of the brick table, must be a multiple of 8
 
 ;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;
 ; Entry point to the program
 ;
 _start:
+    ; the timer needs the initial stack to find the vDSO, so this must happen before anything is pushed
+    mov rdi, rsp
+    call timer_init
 
     lea rdi, [hello_world]
     call print
 
+    call collision_init
     call create_entities
     call create_window
 
 main_loop_start:
     ; get time at start of frame
-    call get_time
+    call get_time_ns
     mov [frame_time], rax
 
+    ; apply every event that has arrived before simulating
+    call process_events
+    cmp rax, 0x0
+    jne main_loop_end
+
+game_logic:
+    mov rax, [right_arrow_status]
+    cmp rax, 0x0
+    je right_arrow_update_finish
+
+    mov rax, [paddle_x]
+    add rax, 10
+    mov [paddle_x], rax
+right_arrow_update_finish:
+
+    mov rax, [left_arrow_status]
+    cmp rax, 0x0
+    je left_arrow_update_finish
+
+    mov rax, [paddle_x]
+    sub rax, 10
+    mov [paddle_x], rax
+left_arrow_update_finish:
+
+    call ball_update
+    call handle_collisions
+    call render
+
+    ; write out anything logged this frame
+    call log_flush
+
+frame_wait_start:
+    ; see how much of the frame is left
+    call get_time_ns
+    mov rbx, [frame_time]
+    sub rax, rbx
+    cmp rax, FRAME_TIME_NS
+    jge main_loop_start
+
+    ; sleep until either the end of the frame or input arrives
+    mov rdi, FRAME_TIME_NS
+    sub rdi, rax
+    call wait_for_event
+
+    ; handle any input straight away so it is ready for the next frame
+    call process_events
+    cmp rax, 0x0
+    jne main_loop_end
+
+    jmp frame_wait_start
+
+main_loop_end:
+
+    lea rdi, [goodbye]
+    call print
+
+    mov rdi, 0x0
+    call exit
+
+;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;
+; Handle every pending event.
+;
+; @returns
+;   0x1 if the game should exit, otherwise 0x0.
+;
+process_events:
+    push rbp
+    mov rbp, rsp
+    push r12
+    sub rsp, 8
+
+process_events_start:
     call try_get_event
     mov r12, rax
 
-    ; no event so go to game logic
+    ; no more events so we are done
     cmp rax, 0x0
-    je game_logic
+    je process_events_end
+
+    ; check if part of the window needs redrawing
+    mov eax, [r12]
+    cmp rax, 0xc
+    jne check_key_event
 
+    mov rax, 0x1
+    mov [full_redraw], rax
+    jmp process_events_start
+
+check_key_event:
     ; check if its a press event
     mov eax, [r12]
     cmp rax, 0x2
@@ -68,7 +158,7 @@ main_loop_start:
     ; check if its a release event
     mov eax, [r12]
     cmp rax, 0x3
-    jne game_logic ; if not go to game logic
+    jne process_events_start ; if not go to next event
 
 handle_key:
     ; get the key code for the release event
@@ -83,7 +173,10 @@ handle_key:
     ; if its key press then exit the game
     mov eax, [r12]
     cmp rax, 0x2
-    je main_loop_end
+    jne process_events_start
+
+    mov rax, 0x1
+    jmp process_events_end
 
 handle_arrow_key:
     ; if it's not an XK_Right then check if its an XK_Left
@@ -96,17 +189,17 @@ handle_arrow_key:
 
     mov rax, 0x1
     mov [right_arrow_status], rax
-    jmp game_logic
+    jmp process_events_start
 
 right_release:
     mov rax, 0x0
     mov [right_arrow_status], rax
-    jmp game_logic
+    jmp process_events_start
 
 left_check:
-    ; if its not an XK_Left then go to game logic
+    ; if its not an XK_Left then go to next event
     cmp rax, 0xff51
-    jne game_logic
+    jne process_events_start
 
     mov eax, [r12]
     cmp rax, 0x2
@@ -114,122 +207,285 @@ left_check:
 
     mov rax, 0x1
     mov [left_arrow_status], rax
-    jmp game_logic
+    jmp process_events_start
 
 left_release:
     mov rax, 0x0
     mov [left_arrow_status], rax
+    jmp process_events_start
 
-game_logic:
-    mov rax, [right_arrow_status]
+process_events_end:
+    add rsp, 8
+    pop r12
+    pop rbp
+    ret
+
+;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;
+; Render the ball, paddle and bricks.
+;
+; Only regions that have changed since the last frame (the old ball and paddle positions and any removed bricks) are
+; cleared, along with the bricks that overlap them. Everything is redrawn if full_redraw is set.
+;
+render:
+    push rbp
+    mov rbp, rsp
+    push r12
+    push r13
+
+    ; ball and paddle have moved so where they were last drawn is dirty
+    lea rdi, [ball_old]
+    call mark_dirty
+    lea rdi, [paddle_old]
+    call mark_dirty
+
+    mov rax, [full_redraw]
     cmp rax, 0x0
-    je right_arrow_update_finish
+    je render_clear_dirty
 
-    mov rax, [paddle_x]
-    add rax, 10
-    mov [paddle_x], rax
-right_arrow_update_finish:
+    ; clear the whole window and draw every brick, one colour at a time so the foreground colour changes as little as
+    ; possible
+    call render_begin
+
+    mov r13, 0x0 ; index of colour being drawn
+
+render_palette_start:
+    cmp r13, [brick_palette_count]
+    je render_all_bricks_end
+
+    mov r12, 0x0 ; index of brick being drawn
+
+render_all_bricks_start:
+    cmp r12, [brick_count]
+    je render_palette_next
+
+    mov eax, [brick_colour + r12 * 4]
+    cmp eax, [brick_palette + r13 * 4]
+    jne render_all_bricks_next
+
+    mov rdi, r12
+    call load_brick
+    mov rdi, rax
+    call draw_entity
+
+render_all_bricks_next:
+    inc r12
+    jmp render_all_bricks_start
+
+render_palette_next:
+    inc r13
+    jmp render_palette_start
+
+render_all_bricks_end:
+    mov rax, 0x0
+    mov [full_redraw], rax
+    jmp render_moving
+
+render_clear_dirty:
+    mov r12, 0x0 ; index of dirty region being cleared
+
+render_clear_dirty_start:
+    cmp r12, [dirty_count]
+    je render_clear_dirty_end
+
+    imul rax, r12, RECT_SIZE
+    lea rax, [dirty_regions + rax]
+    mov rdi, [rax]
+    mov rsi, [rax + 8]
+    mov rdx, [rax + 16]
+    mov rcx, [rax + 24]
+    call clear_rectangle
+
+    inc r12
+    jmp render_clear_dirty_start
+
+render_clear_dirty_end:
+
+    ; redraw any brick that was (partly) cleared
+    mov r12, 0x0 ; index of brick being checked
+
+render_dirty_bricks_start:
+    cmp r12, [brick_count]
+    je render_moving
+
+    mov rdi, r12
+    call load_brick
+    mov rdi, rax
+    call overlaps_dirty
 
-    mov rax, [left_arrow_status]
     cmp rax, 0x0
-    je left_arrow_update_finish
+    je render_dirty_bricks_next
 
-    mov rax, [paddle_x]
-    sub rax, 10
-    mov [paddle_x], rax
-left_arrow_update_finish:
+    lea rdi, [brick_scratch]
+    call draw_entity
 
-    call ball_update
-    call handle_collisions
-    call render
-    
-    ; get end frame time
-    call get_time
+render_dirty_bricks_next:
+    inc r12
+    jmp render_dirty_bricks_start
 
-    ; see if we have spent less than 30ms in this frame
-    mov rbx, [frame_time]
-    sub rax, rbx
-    cmp rax, 30
+render_moving:
+    lea rdi, [ball_x]
+    call draw_entity
 
-    jg main_loop_start
+    lea rdi, [paddle_x]
+    call draw_entity
 
-    ; sleep for remainder of 30ms
-    mov rbx, 30
-    sub rbx, rax
-    mov rdi, rbx
-    call sleep_ms
-        
-    jmp main_loop_start
-main_loop_end:
+    ; remember where the ball and paddle were drawn so they can be cleared next frame
+    movdqu xmm0, [ball_x]
+    movdqu [ball_old], xmm0
+    movdqu xmm0, [ball_x + 16]
+    movdqu [ball_old + 16], xmm0
+    movdqu xmm0, [paddle_x]
+    movdqu [paddle_old], xmm0
+    movdqu xmm0, [paddle_x + 16]
+    movdqu [paddle_old + 16], xmm0
 
-    lea rdi, [goodbye]
-    call print
+    mov rax, 0x0
+    mov [dirty_count], rax
 
-    mov rdi, 0x0
-    call exit
+    call render_end
+
+    pop r13
+    pop r12
+    pop rbp
+    ret
 
 ;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;
-; Render the entity list.
+; Mark a region as needing to be cleared and redrawn in the next call to render. If there are too many dirty regions
+; then the whole window is redrawn instead.
 ;
-render:
+; @param rdi
+;   Address of entity describing region.
+;
+mark_dirty:
     push rbp
     mov rbp, rsp
 
-    call render_begin
+    mov rax, [dirty_count]
+    cmp rax, MAX_DIRTY
+    jne mark_dirty_append
 
-    mov rdi, [entity_list]
-    call linked_list_iterator
-    push rax
+    mov rax, 0x1
+    mov [full_redraw], rax
+    jmp mark_dirty_end
+
+mark_dirty_append:
+    imul rcx, rax, RECT_SIZE
+    lea rcx, [dirty_regions + rcx]
+    movdqu xmm0, [rdi]
+    movdqu [rcx], xmm0
+    movdqu xmm0, [rdi + 16]
+    movdqu [rcx + 16], xmm0
+
+    inc rax
+    mov [dirty_count], rax
+
+mark_dirty_end:
+    pop rbp
+    ret
+
+;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;
+; Check if an entity overlaps any dirty region.
+;
+; @param rdi
+;   Address of entity.
+;
+; @returns
+;   0x1 if entity overlaps a dirty region, otherwise 0x0.
+;
+overlaps_dirty:
+    push rbp
+    mov rbp, rsp
+    push r12
+    push r13
+
+    mov r12, rdi
+    mov r13, 0x0 ; index of dirty region being checked
+
+overlaps_dirty_start:
+    cmp r13, [dirty_count]
+    je overlaps_dirty_none
+
+    mov rdi, r12
+    imul rsi, r13, RECT_SIZE
+    lea rsi, [dirty_regions + rsi]
+    call check_entity_collision
 
-render_loop_start:
-    mov rax, [rsp]
     cmp rax, 0x0
-    je render_loop_end
+    jne overlaps_dirty_end
 
-    mov rdi, [rsp]
-    call linked_list_iterator_value
+    inc r13
+    jmp overlaps_dirty_start
+
+overlaps_dirty_none:
+    mov rax, 0x0
+
+overlaps_dirty_end:
+    pop r13
+    pop r12
+    pop rbp
+    ret
+
+;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;
+; Copy a brick from the brick table into brick_scratch, so it can be used where an entity is expected.
+;
+; @param rdi
+;   Index of brick.
+;
+; @returns
+;   Address of brick_scratch.
+;
+load_brick:
+    push rbp
+    mov rbp, rsp
+
+    movsxd rax, dword [brick_x + rdi * 4]
+    mov [brick_scratch], rax
+    movsxd rax, dword [brick_y + rdi * 4]
+    mov [brick_scratch + 8], rax
+    movsxd rax, dword [brick_width + rdi * 4]
+    mov [brick_scratch + 16], rax
+    movsxd rax, dword [brick_height + rdi * 4]
+    mov [brick_scratch + 24], rax
+    mov eax, [brick_colour + rdi * 4]
+    mov [brick_scratch + 32], rax
+
+    lea rax, [brick_scratch]
+
+    pop rbp
+    ret
 
+;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;
+; Draw an entity.
+;
+; @param rdi
+;   Address of entity.
+;
+draw_entity:
+    push rbp
+    mov rbp, rsp
+
+    mov rax, rdi
     mov rdi, [rax]
     mov rsi, [rax + 8]
     mov rdx, [rax + 16]
     mov rcx, [rax + 24]
+    mov r8, [rax + 32]
     call draw_rectangle
 
-    mov rdi, [rsp]
-    call linked_list_iterator_advance
-    mov [rsp], rax
-    jmp render_loop_start
-
-    call render_end
-render_loop_end:
-
-    add rsp, 0x8
     pop rbp
     ret
 
-
 ;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;
 ; Perform collision detections and resolutions.
 ;
 handle_collisions:
     push rbp
     mov rbp, rsp
-    sub rsp, 8
-
-    mov rdi, [entity_list]
-    call linked_list_iterator
-    mov [rsp], rax
-
-    mov rdi, [rsp]
-    call linked_list_iterator_advance ; move past first entity so we don't check ball collides with itself
-    mov [rsp], rax
+    sub rsp, 16
 
     ; check collision with paddle
-    mov rdi, [rsp]
-    call linked_list_iterator_value
-
     lea rdi, [ball_x]
-    mov rsi, rax
+    lea rsi, [paddle_x]
     call check_entity_collision
 
     cmp rax, 0x0
@@ -239,48 +495,36 @@ handle_collisions:
 
 paddle_collision_end:
 
-    mov rdi, [rsp]
-    call linked_list_iterator_advance ; move passed paddle, onto the bricks
-    mov [rsp], rax
-
-brick_collision_loop_start:
-    ; if we are at the end of the linked list then stop
-    mov rax, [rsp]
-    cmp rax, 0x0
-    je brick_collision_loop_end
-
-    ; get value from the iterator (which will be the address of an entity)
-    mov rdi, [rsp]
-    call linked_list_iterator_value
-
-    ; check if ball is colliding with block
+    ; test the ball against every brick at once
     lea rdi, [ball_x]
-    mov rsi, rax
-    call check_entity_collision
-
-    cmp rax, 0x0
-    jne handle_collision_found
-
-    ; if no collision then move iterator to next block
-    mov rdi, [rsp]
-    call linked_list_iterator_advance
+    lea rsi, [brick_x]
+    lea rdx, [brick_y]
+    lea rcx, [brick_width]
+    lea r8, [brick_height]
+    mov r9, [brick_count]
+    call find_brick_collision
+
+    cmp rax, -1
+    je brick_collision_end
     mov [rsp], rax
 
-    jmp brick_collision_loop_start
+    ; the area the brick covered needs clearing
+    mov rdi, rax
+    call load_brick
+    mov rdi, rax
+    call mark_dirty
 
-handle_collision_found:
-    ; remove block from linked list
-    mov rdi, [entity_list]
-    mov rsi, [rsp]
-    call linked_list_iterator_remove
+    ; remove brick from table
+    mov rdi, [rsp]
+    call brick_table_remove
 
     ; invert ball velocity
     mov rax, 0xa
     mov [ball_velocity_y], rax
 
-brick_collision_loop_end:
+brick_collision_end:
 
-    add rsp, 8
+    add rsp, 16
     pop rbp
     ret
 
@@ -445,52 +689,51 @@ ball_update_end:
     ret
 
 ;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;
-; Create all the entities for the game and insert them into a linked list.
+; Create all the bricks for the game and insert them into the brick table.
 ;
 create_entities:
     push rbp
     mov rbp, rsp
 
-    call linked_list_init
-    mov [entity_list], rax
-
-    ; collision code assumes ball is first in the entity list, then the paddle then the bricks
-    mov rdi, [entity_list]
-    lea rsi, [ball_x] ; store address of ball in list
-    call linked_list_push_back
-
-    mov rdi, [entity_list]
-    lea rsi, [paddle_x] ; store address of paddle data in list
-    call linked_list_push_back
-
+    ; ball and paddle live at fixed addresses, only the bricks go in the table
     mov rdi, 50
+    mov rsi, 0xff0000
     call create_brick_row
     mov rdi, 80
+    mov rsi, 0xff0000
     call create_brick_row
     mov rdi, 110
+    mov rsi, 0xffa500
     call create_brick_row
     mov rdi, 140
+    mov rsi, 0xffa500
     call create_brick_row
     mov rdi, 170
+    mov rsi, 0x00ff00
     call create_brick_row
     mov rdi, 200
+    mov rsi, 0x00ff00
     call create_brick_row
 
     pop rbp
     ret
 
 ;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;
-; Adds a row of 10 bricks to the entity list
+; Adds a row of 10 bricks to the brick table
 ;
 ; @param rdi
 ;   Y coord of row.
 ;
+; @param rsi
+;   Colour of bricks, as 0xRRGGBB.
+;
 create_brick_row:
     push rbp
     mov rbp, rsp
-    sub rsp, 24
+    sub rsp, 32
 
     mov [rsp + 16], rdi
+    mov [rsp + 24], rsi
 
     mov rax, 0
     mov [rsp], rax ; store loop counter
@@ -503,22 +746,12 @@ create_row_start:
     cmp rax, 10
     je create_row_end ; leave loop if we have added 10 bricks
 
-    mov rdi, 32
-    call memory_malloc
-
-    ; fill out entity struct
-    mov rbx, [rsp + 8]
-    mov [rax], rbx
-    mov rbx, [rsp + 16]
-    mov [rax + 8], rbx
-    mov rbx, 58
-    mov [rax + 16], rbx
-    mov rbx, 20
-    mov [rax + 24], rbx
-
-    mov rdi, [entity_list]
-    mov rsi, rax
-    call linked_list_push_back
+    mov rdi, [rsp + 8]
+    mov rsi, [rsp + 16]
+    mov rdx, 58
+    mov rcx, 20
+    mov r8, [rsp + 24]
+    call brick_table_add
 
     ; advance x coord for next iteration
     mov rax, [rsp + 8]
@@ -533,27 +766,156 @@ create_row_start:
 
 create_row_end:
 
-    add rsp, 24
+    add rsp, 32
+    pop rbp
+    ret
+
+;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;
+; Add a brick to the end of the brick table.
+;
+; @param rdi
+;   X coord of brick.
+;
+; @param rsi
+;   Y coord of brick.
+;
+; @param rdx
+;   Width of brick.
+;
+; @param rcx
+;   Height of brick.
+;
+; @param r8
+;   Colour of brick, as 0xRRGGBB.
+;
+brick_table_add:
+    push rbp
+    mov rbp, rsp
+
+    push rdi
+    push rsi
+
+    ; check there is space for another brick
+    mov rdi, MAX_BRICKS
+    sub rdi, [brick_count]
+    lea rsi, [brick_table_full]
+    call assert_not_null
+
+    pop rsi
+    pop rdi
+
+    ; write brick into first unused slot
+    mov rax, [brick_count]
+    mov [brick_x + rax * 4], edi
+    mov [brick_y + rax * 4], esi
+    mov [brick_width + rax * 4], edx
+    mov [brick_height + rax * 4], ecx
+    mov [brick_colour + rax * 4], r8d
+
+    inc rax
+    mov [brick_count], rax
+
+    ; add colour to the palette if we haven't seen it before
+    mov rcx, 0x0
+brick_palette_search_start:
+    cmp rcx, [brick_palette_count]
+    je brick_palette_add
+
+    cmp r8d, [brick_palette + rcx * 4]
+    je brick_table_add_end
+
+    inc rcx
+    jmp brick_palette_search_start
+
+brick_palette_add:
+    push r8
+    push rcx
+
+    mov rdi, MAX_PALETTE
+    sub rdi, rcx
+    lea rsi, [brick_palette_full]
+    call assert_not_null
+
+    pop rcx
+    pop r8
+
+    mov [brick_palette + rcx * 4], r8d
+    inc rcx
+    mov [brick_palette_count], rcx
+
+brick_table_add_end:
+
+    pop rbp
+    ret
+
+;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;
+; Remove a brick from the brick table. The last brick is moved into its place, so the order of bricks is not
+; preserved.
+;
+; @param rdi
+;   Index of brick to remove.
+;
+brick_table_remove:
+    push rbp
+    mov rbp, rsp
+
+    mov rax, [brick_count]
+    dec rax
+    mov [brick_count], rax
+
+    ; copy last brick over the removed one (harmless if they are the same brick)
+    mov ecx, [brick_x + rax * 4]
+    mov [brick_x + rdi * 4], ecx
+    mov ecx, [brick_y + rax * 4]
+    mov [brick_y + rdi * 4], ecx
+    mov ecx, [brick_width + rax * 4]
+    mov [brick_width + rdi * 4], ecx
+    mov ecx, [brick_height + rax * 4]
+    mov [brick_height + rdi * 4], ecx
+    mov ecx, [brick_colour + rax * 4]
+    mov [brick_colour + rdi * 4], ecx
+
     pop rbp
     ret
 
 section .data
-    entity_list: dq 0x0
     paddle_x: dq 0x12c
     paddle_y: dq 0x30c
     paddle_width: dq 0xc8
     paddle_height: dq 0x14
+    paddle_colour: dq 0xffffff
     ball_x: dq 0x1a4
     ball_y: dq 0x190
     ball_width: dq 0xa
     ball_height: dq 0xa
+    ball_colour: dq 0xffffff
     ball_velocity_y: dq 0xa
     ball_velocity_x: dq 0x0
     left_arrow_status: dq 0x0
     right_arrow_status: dq 0x0
     frame_time: dq 0x0
+    brick_count: dq 0x0
+    brick_palette_count: dq 0x0
+    full_redraw: dq 0x1
+    dirty_count: dq 0x0
+    ball_old: times 4 dq 0x0
+    paddle_old: times 4 dq 0x0
+
+section .bss
+    ; brick table, stored as a column per field so collisions can be tested for several bricks at once
+    alignb 32
+    brick_x: resd MAX_BRICKS
+    brick_y: resd MAX_BRICKS
+    brick_width: resd MAX_BRICKS
+    brick_height: resd MAX_BRICKS
+    brick_colour: resd MAX_BRICKS
+    brick_palette: resd MAX_PALETTE ; every distinct brick colour
+    brick_scratch: resq 5 ; a single brick, in entity layout
+    dirty_regions: resq MAX_DIRTY * 4 ; regions to clear next frame, in entity layout
 
 section .rodata
     hello_world: db "hello world", 0xa, 0x0
     goodbye: db "goodbye", 0xa, 0x0
     sleep_for: db "sleep_for: ", 0x0
+    brick_table_full: db "brick table full", 0xa, 0x0
+    brick_palette_full: db "brick palette full", 0xa, 0x0
@@ -0,0 +1,412 @@
+;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;
+;;         Distributed under the Boost Software License, Version 1.0.          ;;
+;;            (See accompanying file LICENSE or copy at                        ;;
+;;                 https://www.boost.org/LICENSE_1_0.txt)                      ;;
+;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;
+
+global get_time_ns
+global sleep_ns
+global timer_init
+
+;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;
+; This file contains a high resolution monotonic timer.
+;
+; Time is read from CLOCK_MONOTONIC via the vDSO (so no syscall is made), which is found through the auxiliary vector
+; the kernel places on the initial stack. If the CPU has an invariant TSC then rdtsc is calibrated against the clock at
+; start up and used instead, which is cheaper still. If neither is available then the clock_gettime syscall is used.
+
+AT_SYSINFO_EHDR equ 33 ; auxiliary vector entry holding the address of the vDSO
+CLOCK_MONOTONIC equ 1
+CALIBRATION_NS equ 10000000 ; how long to measure the TSC for, long enough to make clock read jitter negligible
+NS_PER_SECOND equ 1000000000
+
+;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;
+; Initialise the timer, this must be called before any other timer function.
+;
+; @param rdi
+;   Value of rsp on entry to _start (i.e. address of argc).
+;
+timer_init:
+    push rbp
+    mov rbp, rsp
+
+    ; skip argc and argv (which is null terminated)
+    mov rax, [rdi]
+    lea rdi, [rdi + rax * 8 + 16]
+
+    ; skip envp (which is also null terminated)
+timer_init_skip_env:
+    mov rax, [rdi]
+    add rdi, 0x8
+    cmp rax, 0x0
+    jne timer_init_skip_env
+
+    ; rdi now points at the auxiliary vector, a list of type and value pairs ending with AT_NULL
+timer_init_auxv_start:
+    mov rax, [rdi]
+    cmp rax, 0x0
+    je timer_init_calibrate
+
+    cmp rax, AT_SYSINFO_EHDR
+    je timer_init_auxv_found
+
+    add rdi, 0x10
+    jmp timer_init_auxv_start
+
+timer_init_auxv_found:
+    mov rdi, [rdi + 8]
+    lea rsi, [clock_gettime_name]
+    call vdso_lookup
+    mov [vdso_clock_gettime], rax
+
+timer_init_calibrate:
+    call calibrate_tsc
+
+    pop rbp
+    ret
+
+;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;
+; Get the current time.
+;
+; @returns
+;   Nanoseconds since an arbitrary (but fixed) point in the past.
+;
+get_time_ns:
+    push rbp
+    mov rbp, rsp
+
+    mov rax, [tsc_mult]
+    cmp rax, 0x0
+    je get_time_ns_clock
+
+    ; convert ticks since calibration to nanoseconds, the 128 bit product means this can't overflow
+    rdtsc
+    shl rdx, 32
+    or rax, rdx
+    sub rax, [tsc_base]
+    mul qword [tsc_mult]
+    shrd rax, rdx, 32
+    add rax, [tsc_base_ns]
+    jmp get_time_ns_end
+
+get_time_ns_clock:
+    call clock_gettime_ns
+
+get_time_ns_end:
+    pop rbp
+    ret
+
+;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;
+; Sleep the current process for the supplied number of nanoseconds.
+;
+; @param rdi
+;   Number of nanoseconds to sleep for.
+;
+sleep_ns:
+    push rbp
+    mov rbp, rsp
+
+    ; create struct timespec on the stack
+    mov rax, rdi
+    mov rdx, 0x0
+    mov rcx, NS_PER_SECOND
+    div rcx
+    push rdx ; tv_nsec
+    push rax ; tv_sec
+
+    ; clock_nanosleep syscall, with a relative time
+    mov rax, 0xe6
+    mov rdi, CLOCK_MONOTONIC
+    mov rsi, 0x0
+    mov rdx, rsp
+    mov r10, 0x0
+    syscall
+
+    leave
+    ret
+
+;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;
+; Read CLOCK_MONOTONIC, via the vDSO if it was found otherwise via a syscall.
+;
+; @returns
+;   Nanoseconds since an arbitrary (but fixed) point in the past.
+;
+clock_gettime_ns:
+    push rbp
+    mov rbp, rsp
+    sub rsp, 0x10 ; struct timespec
+
+    mov rdi, CLOCK_MONOTONIC
+    mov rsi, rsp
+
+    mov rax, [vdso_clock_gettime]
+    cmp rax, 0x0
+    je clock_gettime_ns_syscall
+
+    call rax
+    jmp clock_gettime_ns_convert
+
+clock_gettime_ns_syscall:
+    mov rax, 0xe4
+    syscall
+
+clock_gettime_ns_convert:
+    mov rax, [rsp] ; tv_sec
+    imul rax, rax, NS_PER_SECOND
+    add rax, [rsp + 8] ; tv_nsec
+
+    leave
+    ret
+
+;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;
+; Measure the TSC frequency against CLOCK_MONOTONIC. If the TSC isn't invariant (i.e. its rate can change with power
+; state) then it isn't used and tsc_mult is left as 0x0.
+;
+; The process sleeps for the calibration period rather than spinning, the rate only depends on the two end points so
+; oversleeping doesn't affect it.
+;
+calibrate_tsc:
+    push rbp
+    mov rbp, rsp
+    push rbx ; cpuid clobbers rbx
+    push r12
+    push r13
+    push r14
+
+    ; check cpuid supports the advanced power management leaf
+    mov eax, 0x80000000
+    cpuid
+    cmp eax, 0x80000007
+    jb calibrate_tsc_end
+
+    ; check for invariant TSC
+    mov eax, 0x80000007
+    cpuid
+    test edx, 0x100
+    jz calibrate_tsc_end
+
+    call clock_gettime_ns
+    mov r12, rax ; start time
+
+    rdtsc
+    shl rdx, 32
+    or rax, rdx
+    mov r13, rax ; start ticks
+
+    mov rdi, CALIBRATION_NS
+    call sleep_ns
+
+    call clock_gettime_ns
+    mov r14, rax ; end time
+
+    rdtsc
+    shl rdx, 32
+    or rax, rdx
+    sub rax, r13
+    mov rbx, rax ; ticks elapsed
+
+    cmp rbx, 0x0
+    je calibrate_tsc_end
+
+    ; nanoseconds per tick as a 32.32 fixed point number, i.e. (elapsed ns << 32) / elapsed ticks
+    mov rax, r14
+    sub rax, r12
+    mov rdx, rax
+    shr rdx, 32
+    shl rax, 32
+    div rbx
+
+    mov [tsc_mult], rax
+    mov [tsc_base], r13
+    mov [tsc_base_ns], r12
+
+calibrate_tsc_end:
+    pop r14
+    pop r13
+    pop r12
+    pop rbx
+    pop rbp
+    ret
+
+;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;
+; Find the address of a symbol exported by the vDSO.
+;
+; @param rdi
+;   Address of vDSO ELF header.
+;
+; @param rsi
+;   Address of null terminated symbol name.
+;
+; @returns
+;   Address of symbol, or 0x0 if it could not be found.
+;
+vdso_lookup:
+    push rbp
+    mov rbp, rsp
+    push rbx
+    push r12
+    push r13
+    push r14
+    push r15
+    sub rsp, 0x8 ; space for load bias
+
+    mov r12, rsi
+
+    ; walk program headers to find the load bias and the dynamic section
+    mov r8, [rdi + 32] ; e_phoff
+    add r8, rdi
+    movzx r9, word [rdi + 54] ; e_phentsize
+    movzx r10, word [rdi + 56] ; e_phnum
+    mov rbx, 0x0 ; address of dynamic section
+
+vdso_lookup_phdr_start:
+    cmp r10, 0x0
+    je vdso_lookup_phdr_end
+
+    mov eax, [r8] ; p_type
+    cmp eax, 0x1 ; PT_LOAD
+    jne vdso_lookup_phdr_dynamic
+
+    ; load bias is where the vDSO is mapped minus the address it was linked at
+    mov rax, rdi
+    add rax, [r8 + 8] ; p_offset
+    sub rax, [r8 + 16] ; p_vaddr
+    mov [rsp], rax
+    jmp vdso_lookup_phdr_next
+
+vdso_lookup_phdr_dynamic:
+    cmp eax, 0x2 ; PT_DYNAMIC
+    jne vdso_lookup_phdr_next
+    mov rbx, [r8 + 16] ; p_vaddr
+
+vdso_lookup_phdr_next:
+    add r8, r9
+    dec r10
+    jmp vdso_lookup_phdr_start
+
+vdso_lookup_phdr_end:
+    cmp rbx, 0x0
+    je vdso_lookup_not_found
+    add rbx, [rsp]
+
+    ; walk dynamic section to find the symbol, string and hash tables
+    mov r13, 0x0 ; symbol table
+    mov r14, 0x0 ; string table
+    mov r15, 0x0 ; hash table
+
+vdso_lookup_dynamic_start:
+    mov rax, [rbx] ; d_tag
+    cmp rax, 0x0 ; DT_NULL
+    je vdso_lookup_dynamic_end
+
+    mov rcx, [rbx + 8] ; d_ptr
+    add rcx, [rsp]
+
+    cmp rax, 0x4 ; DT_HASH
+    cmove r15, rcx
+    cmp rax, 0x5 ; DT_STRTAB
+    cmove r14, rcx
+    cmp rax, 0x6 ; DT_SYMTAB
+    cmove r13, rcx
+
+    add rbx, 0x10
+    jmp vdso_lookup_dynamic_start
+
+vdso_lookup_dynamic_end:
+    cmp r13, 0x0
+    je vdso_lookup_not_found
+    cmp r14, 0x0
+    je vdso_lookup_not_found
+    cmp r15, 0x0
+    je vdso_lookup_not_found
+
+    ; number of symbols is nchain from the hash table
+    mov ebx, [r15 + 4]
+
+vdso_lookup_symbol_start:
+    cmp rbx, 0x0
+    je vdso_lookup_not_found
+
+    ; skip undefined symbols
+    movzx eax, word [r13 + 6] ; st_shndx
+    cmp eax, 0x0
+    je vdso_lookup_symbol_next
+
+    mov eax, [r13] ; st_name
+    lea rdi, [r14 + rax]
+    mov rsi, r12
+    call string_equal
+
+    cmp rax, 0x0
+    je vdso_lookup_symbol_next
+
+    mov rax, [r13 + 8] ; st_value
+    add rax, [rsp]
+    jmp vdso_lookup_end
+
+vdso_lookup_symbol_next:
+    add r13, 0x18 ; sizeof(Elf64_Sym)
+    dec rbx
+    jmp vdso_lookup_symbol_start
+
+vdso_lookup_not_found:
+    mov rax, 0x0
+
+vdso_lookup_end:
+    add rsp, 0x8
+    pop r15
+    pop r14
+    pop r13
+    pop r12
+    pop rbx
+    pop rbp
+    ret
+
+;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;
+; Compare two strings.
+;
+; @param rdi
+;   Address of first null terminated string.
+;
+; @param rsi
+;   Address of second null terminated string.
+;
+; @returns
+;   0x1 if strings are equal, otherwise 0x0.
+;
+string_equal:
+    push rbp
+    mov rbp, rsp
+
+string_equal_start:
+    movzx eax, byte [rdi]
+    movzx ecx, byte [rsi]
+    cmp eax, ecx
+    jne string_equal_false
+
+    cmp eax, 0x0
+    je string_equal_true
+
+    inc rdi
+    inc rsi
+    jmp string_equal_start
+
+string_equal_true:
+    mov rax, 0x1
+    jmp string_equal_end
+
+string_equal_false:
+    mov rax, 0x0
+
+string_equal_end:
+    pop rbp
+    ret
+
+section .data
+    vdso_clock_gettime: dq 0x0 ; address of __vdso_clock_gettime, or 0x0 if not found
+    tsc_mult: dq 0x0 ; nanoseconds per TSC tick (32.32 fixed point), or 0x0 if the TSC isn't used
+    tsc_base: dq 0x0 ; TSC value at calibration
+    tsc_base_ns: dq 0x0 ; time at calibration
+
+section .rodata
+    clock_gettime_name: db "__vdso_clock_gettime", 0x0
@@ -9,16 +9,19 @@ global assert_null
 global exit
 global game_malloc
 global game_mmap
-global get_time
+global log_append
+global log_flush
+global log_number
 global print
 global print_num
-global sleep_ms
 
 ;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;
 ; This file contains various utilities.
 
+LOG_BUFFER_SIZE equ 0x1000 ; size of STDOUT buffer, must be a power of two
+
 ;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;
-; Print a string to STDOUT.
+; Print a string to STDOUT. Output is buffered, see log_flush.
 ;
 ; @param rdi
 ;   Address of null terminated string to print.
@@ -29,34 +32,22 @@ global sleep_ms
 print:
     push rbp
     mov rbp, rsp
+    push rdi
 
-    mov r10, rdi ; save off string address
-    mov r9, rdi ; iterator register for string
-    movzx rax, byte [r9] ; load first byte
-    mov rcx, 0x0 ; accumulator for string length
-
-count_null_start:
-    cmp rax, 0x0 ; are we at the null byte?
-    je count_null_end
-
-    inc rcx ; increment accumulator
-    inc r9 ; move to next byte
-    movzx rax, byte [r9] ; load byte
-    jmp count_null_start 
+    call string_length
+    push rax
 
-count_null_end:
-    ; syscall to write string to stdout
-    mov rax, 0x1
-    mov rdi, 0x1;
-    mov rsi, r10
-    mov rdx, rcx
-    syscall
+    mov rdi, [rsp + 8]
+    mov rsi, rax
+    call log_append
 
+    pop rax
+    add rsp, 0x8
     pop rbp
     ret
 
 ;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;
-; Print an integer to STDOUT (with a new line).
+; Print an integer to STDOUT (with a new line). Output is buffered, see log_flush.
 ;
 ; @param rdi
 ;   Unsigned number to print.
@@ -64,64 +55,241 @@ count_null_end:
 print_num:
     push rbp
     mov rbp, rsp
-    sub rsp, 0x15 ; get stack space for two buffers, one to convert the number into a string (in reverse order)]
-                  ; and another to reverse the string into
 
-    mov r9, rdi ; r9 will be the mutable copy of the input number
-    mov rdx, rdi
-    mov rcx, 0x0 ; accumulator for string length
+    call log_number
+
+    lea rdi, [newline]
+    mov rsi, 0x1
+    call log_append
+
+    pop rbp
+    ret
+
+;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;
+; Append an integer to the STDOUT buffer.
+;
+; @param rdi
+;   Unsigned number to append.
+;
+log_number:
+    push rbp
+    mov rbp, rsp
+    sub rsp, 0x20 ; buffer to convert number into, the largest 64 bit number has 20 digits
+
+    mov rax, rdi
+    mov rcx, rbp ; digits are written backwards from the end of the buffer, so no reversing is needed
+    mov r8, 0xa
+
+log_number_digit_start:
+    mov rdx, 0x0
+    div r8 ; rdx = remainder, rax = quotient
+
+    add rdx, 0x30 ; convert remainder to ASCII
+    dec rcx
+    mov [rcx], dl
+
+    cmp rax, 0x0
+    jne log_number_digit_start
+
+    mov rdi, rcx
+    mov rsi, rbp
+    sub rsi, rcx ; number of digits
+    call log_append
+
+    leave
+    ret
 
-    mov rdi, rsp ; set destination as start of first buffer
+;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;
+; Append bytes to the STDOUT buffer. If there isn't enough free space then the buffer is flushed first.
+;
+; The buffer is a ring, bytes between log_tail and log_head (which only ever increase) are waiting to be written.
+;
+; @param rdi
+;   Address of bytes to append.
+;
+; @param rsi
+;   Number of bytes to append.
+;
+log_append:
+    push rbp
+    mov rbp, rsp
+    push r12
+    push r13
 
-write_loop_start:
+    mov r12, rdi
+    mov r13, rsi
 
-    mov rax, r9 ; load number to be divided
-    mov rdx, 0 ; zero out remainder
-    mov r10, 0xa ; divisor by 10
-    div r10 ; rdx = remainder, rax = quotient
+    ; check if the bytes fit in the free space
+    mov rax, [log_head]
+    sub rax, [log_tail]
+    add rax, r13
+    cmp rax, LOG_BUFFER_SIZE
+    jbe log_append_copy
 
-    mov r11, 0x30
-    add rdx, r11 ; add 0x30 to remainder to get ASCII code for number
+    call log_flush
 
-    mov [rdi], dl ; write ASCII byte to buffer
-    inc rcx ; increment how many characters have been written
+    ; anything bigger than the whole buffer is written directly
+    cmp r13, LOG_BUFFER_SIZE
+    jbe log_append_copy
 
-    cmp rax, 0x0 ; check if we have reached the end
-    je write_loop_end
-    
-    inc rdi
-    mov r9, rax ; load remainder into r9 so it can be divided again
-    jmp write_loop_start
+log_append_write:
+    ; write syscall
+    mov rax, 0x1
+    mov rdi, 0x1
+    mov rsi, r12
+    mov rdx, r13
+    syscall
 
-write_loop_end:
+    ; retry if interrupted
+    cmp rax, -4 ; EINTR
+    je log_append_write
+
+    ; on any other error drop the output, rather than retrying forever
+    cmp rax, 0x0
+    jle log_append_end
+
+    ; advance past what was written, and go round again if it was a partial write
+    add r12, rax
+    sub r13, rax
+    jnz log_append_write
+    jmp log_append_end
+
+log_append_copy:
+    ; copy as much as fits before the end of the buffer
+    mov rdi, [log_head]
+    and rdi, LOG_BUFFER_SIZE - 1
+    mov rcx, LOG_BUFFER_SIZE
+    sub rcx, rdi
+    cmp rcx, r13
+    cmova rcx, r13
+    mov rdx, rcx
+    lea rdi, [log_buffer + rdi]
+    mov rsi, r12
+    rep movsb
+
+    ; copy the rest (if any) to the start of the buffer
+    mov rcx, r13
+    sub rcx, rdx
+    lea rdi, [log_buffer]
+    rep movsb
+
+    mov rax, [log_head]
+    add rax, r13
+    mov [log_head], rax
+
+log_append_end:
+    pop r13
+    pop r12
+    pop rbp
+    ret
 
-    mov rsi, rdi ; move destination into source so we can reverse it
-    mov rdi, rsp
-    add rdi, 0xa ; set destination to start of second buffer
+;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;
+; Write everything in the STDOUT buffer, with a single writev unless the write is interrupted or partial.
+;
+log_flush:
+    push rbp
+    mov rbp, rsp
+    sub rsp, 0x20 ; space for two struct iovec
 
-reverse_loop_start:
+log_flush_start:
+    mov rcx, [log_head]
+    sub rcx, [log_tail] ; bytes waiting to be written
     cmp rcx, 0x0
-    je reverse_loop_end
+    je log_flush_end
+
+    ; first iovec runs from the tail up to the end of the buffer
+    mov rax, [log_tail]
+    and rax, LOG_BUFFER_SIZE - 1
+    lea rdx, [log_buffer + rax]
+    mov [rsp], rdx ; iov_base
+    mov rdx, LOG_BUFFER_SIZE
+    sub rdx, rax
+    cmp rdx, rcx
+    cmova rdx, rcx
+    mov [rsp + 8], rdx ; iov_len
+
+    ; second iovec is whatever wrapped around to the start of the buffer
+    lea rax, [log_buffer]
+    mov [rsp + 16], rax ; iov_base
+    sub rcx, rdx
+    mov [rsp + 24], rcx ; iov_len
+
+    ; writev syscall
+    mov rax, 0x14
+    mov rdi, 0x1
+    mov rsi, rsp
+    mov rdx, 0x2
+    syscall
 
-    movzx rax, byte[rsi]
-    mov [rdi], al ; write ascii character into second buffer
-    dec rsi
-    inc rdi
+    ; retry if interrupted
+    cmp rax, -4 ; EINTR
+    je log_flush_start
 
-    dec rcx; ; keep track of how many characters we've reversed
-    jmp reverse_loop_start
-reverse_loop_end:
+    ; on any other error drop the output, rather than retrying forever
+    cmp rax, 0x0
+    jle log_flush_drop
 
-    mov rax, 0xa
-    mov [rdi], al ; write newline character into the end
+    ; advance past what was written, and go round again if it was a partial write
+    add rax, [log_tail]
+    mov [log_tail], rax
+    jmp log_flush_start
 
-    mov rdi, rsp
-    add rdi, 0xa ; print second buffer
-    call print
+log_flush_drop:
+    mov rax, [log_head]
+    mov [log_tail], rax
 
+log_flush_end:
     leave
     ret
 
+;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;
+; Get the length of a string, checking 16 bytes at a time.
+;
+; @param rdi
+;   Address of null terminated string.
+;
+; @returns
+;   Number of bytes before the null terminator.
+;
+string_length:
+    push rbp
+    mov rbp, rsp
+
+    ; aligned loads never cross a page boundary, so reading the rest of a block past the terminator is safe
+    mov rax, rdi
+    and rax, -16 ; block containing the first byte
+    mov rcx, rdi
+    and rcx, 0xf ; offset of the first byte in the block
+
+    pxor xmm0, xmm0
+    movdqa xmm1, [rax]
+    pcmpeqb xmm1, xmm0
+    pmovmskb edx, xmm1 ; one bit per null byte
+    shr edx, cl ; ignore bytes before the start of the string
+
+    cmp edx, 0x0
+    je string_length_block_start
+
+    bsf eax, edx
+    jmp string_length_end
+
+string_length_block_start:
+    add rax, 0x10
+    movdqa xmm1, [rax]
+    pcmpeqb xmm1, xmm0
+    pmovmskb edx, xmm1
+
+    cmp edx, 0x0
+    je string_length_block_start
+
+    bsf edx, edx
+    add rax, rdx
+    sub rax, rdi
+
+string_length_end:
+    pop rbp
+    ret
+
 ;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;
 ; Assert the input is not null.
 ;
@@ -177,70 +345,26 @@ assert_null_end:
     ret
 
 ;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;
-; Exit the program.
+; Exit the program, after flushing any buffered output.
 ;
 ; @param rdi
 ;   Exit code.
 ;
 exit:
-    mov rax, 0x3c
-    syscall
+    push rdi
+    call log_flush
+    pop rdi
 
-;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;
-; Sleep the current process for the supplied number of milliseconds.
-;
-; @param rdi
-;   Number of milliseconds to sleep for.
-;
-sleep_ms:
-    push rbp
-    mov rbp, rsp
-
-    imul rdi, rdi, 1000000 ; convert supplied ms to ns
-    xor rax, rax 
-    ; recreate struct timepec on the stack
-    push rdi ; tv_nsec
-    push rax ; tv_sec
-
-    ; nanosleep syscall
-    mov rax, 0x23
-    mov rdi, rsp
-    mov rsi, 0x0
-    syscall
-
-    add rsp, 16
-
-    pop rbp
-    ret
-
-;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;
-; Get the time since epoch in milliseconds.
-;
-; @returns
-;   Milliseconds since epoch.
-;
-get_time:
-    push rbp
-    mov rbp, rsp
-
-    ; create empty timeval struct on the stack
-    push 0x0 ; tv_usec
-    push 0x0 ; tv_sec
-
-    ; gettimeofday syscall
-    mov rax, 0x60
-    mov rdi, rsp
-    mov rsi, 0x0
+    mov rax, 0x3c
     syscall
 
-    pop rax ; seconds
-    pop rbx ; microseconds
+section .data
+    log_head: dq 0x0 ; total number of bytes ever appended to the STDOUT buffer
+    log_tail: dq 0x0 ; total number of bytes ever written from the STDOUT buffer
 
-    imul rax, rax, 1000000 ; convert seconds to microseconds
-    add rax, rbx ; add microseconds
-    mov rdx, 0x0
-    mov rbx, 1000
-    div rbx ; convert to milliseconds
+section .bss
+    alignb 16
+    log_buffer: resb LOG_BUFFER_SIZE
 
-    pop rbp
-    ret
+section .rodata
+    newline: db 0xa
@@ -0,0 +1,58 @@
+////////////////////////////////////////////////////////////////////////////////
+//         Distributed under the Boost Software License, Version 1.0.         //
+//            (See accompanying file LICENSE or copy at                       //
+//                 https://www.boost.org/LICENSE_1_0.txt)                     //
+////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <assert.h>
+#include <stdint.h>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+/**
+ * Portable wrappers for bit manipulation intrinsics.
+ */
+
+/**
+ * Count the number of trailing zero bits in a value.
+ *
+ * @param value
+ *   Value to count, must not be 0.
+ *
+ * @returns
+ *   Index of the lowest set bit.
+ */
+static inline unsigned c_count_trailing_zeros(uint64_t value)
+{
+    assert(value != 0u);
+
+#if defined(_MSC_VER)
+    unsigned long index = 0u;
+    _BitScanForward64(&index, value);
+    return (unsigned)index;
+#else
+    return (unsigned)__builtin_ctzll(value);
+#endif
+}
+
+/**
+ * Count the number of set bits in a value.
+ *
+ * @param value
+ *   Value to count.
+ *
+ * @returns
+ *   Number of set bits.
+ */
+static inline unsigned c_count_set_bits(uint64_t value)
+{
+#if defined(_MSC_VER)
+    return (unsigned)__popcnt64(value);
+#else
+    return (unsigned)__builtin_popcountll(value);
+#endif
+}
@@ -0,0 +1,208 @@
+////////////////////////////////////////////////////////////////////////////////
+//         Distributed under the Boost Software License, Version 1.0.         //
+//            (See accompanying file LICENSE or copy at                       //
+//                 https://www.boost.org/LICENSE_1_0.txt)                     //
+////////////////////////////////////////////////////////////////////////////////
+
+#include "c_brick_grid.h"
+
+#include <assert.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "c_bits.h"
+#include "c_rectangle.h"
+#include "c_scalar.h"
+#include "c_vector2.h"
+
+/**
+ * Helper function to convert an estimated brick index to an index in the range [0, count].
+ *
+ * @param estimate
+ *   Estimated index, this is the ratio of two scalars so is unscaled in either mode.
+ *
+ * @param count
+ *   Number of bricks.
+ *
+ * @returns
+ *   Clamped index.
+ */
+static size_t clamp_index(C_Scalar estimate, size_t count)
+{
+    if (estimate <= 0)
+    {
+        return 0u;
+    }
+
+    return (estimate >= (C_Scalar)count) ? count : (size_t)estimate;
+}
+
+/**
+ * Helper function to find the range of bricks along one axis which a span intersects with.
+ *
+ * The range is first estimated by division and then nudged, using the same comparisons as a rectangle test, so it is
+ * exact even when the span sits right on a brick edge.
+ *
+ * @param origin
+ *   Position of the first brick.
+ *
+ * @param pitch
+ *   Distance between adjacent bricks.
+ *
+ * @param size
+ *   Size of a brick.
+ *
+ * @param count
+ *   Number of bricks.
+ *
+ * @param start
+ *   Start of span.
+ *
+ * @param length
+ *   Length of span.
+ *
+ * @param first
+ *   Out parameter for index of first brick intersected.
+ *
+ * @param end
+ *   Out parameter for one past the index of the last brick intersected, this will equal first if none are.
+ */
+static void intersecting_range(
+    C_Scalar origin,
+    C_Scalar pitch,
+    C_Scalar size,
+    size_t count,
+    C_Scalar start,
+    C_Scalar length,
+    size_t *first,
+    size_t *end)
+{
+    const C_Scalar span_end = start + length;
+
+    // first brick whose far edge is past the start of the span
+    size_t first_index = clamp_index((start - origin - size) / pitch, count);
+    while ((first_index > 0u) && (start < origin + ((C_Scalar)(first_index - 1u) * pitch) + size))
+    {
+        --first_index;
+    }
+    while ((first_index < count) && !(start < origin + ((C_Scalar)first_index * pitch) + size))
+    {
+        ++first_index;
+    }
+
+    // one past the last brick whose near edge is before the end of the span
+    size_t end_index = clamp_index((span_end - origin) / pitch, count);
+    while ((end_index < count) && (span_end > origin + ((C_Scalar)end_index * pitch)))
+    {
+        ++end_index;
+    }
+    while ((end_index > first_index) && !(span_end > origin + ((C_Scalar)(end_index - 1u) * pitch)))
+    {
+        --end_index;
+    }
+
+    *first = first_index;
+    *end = (end_index < first_index) ? first_index : end_index;
+}
+
+C_BrickGrid c_brick_grid_create(
+    const C_Vector2 *origin,
+    C_Scalar brick_width,
+    C_Scalar brick_height,
+    C_Scalar column_pitch,
+    C_Scalar row_pitch,
+    size_t columns,
+    size_t rows)
+{
+    assert(origin != NULL);
+    assert(brick_width <= column_pitch);
+    assert(brick_height <= row_pitch);
+    assert(columns <= C_BRICK_GRID_MAX_COLUMNS);
+    assert(rows <= C_BRICK_GRID_MAX_ROWS);
+
+    return (C_BrickGrid){
+        .origin = *origin,
+        .brick_width = brick_width,
+        .brick_height = brick_height,
+        .column_pitch = column_pitch,
+        .row_pitch = row_pitch,
+        .columns = columns,
+        .rows = rows};
+}
+
+void c_brick_grid_fill_row(C_BrickGrid *grid, size_t row, uint8_t r, uint8_t g, uint8_t b)
+{
+    assert(grid != NULL);
+    assert(row < grid->rows);
+
+    grid->row_masks[row] =
+        (grid->columns == C_BRICK_GRID_MAX_COLUMNS) ? ~UINT64_C(0) : ((UINT64_C(1) << grid->columns) - 1u);
+    grid->r[row] = r;
+    grid->g[row] = g;
+    grid->b[row] = b;
+}
+
+size_t c_brick_grid_remove_intersecting(C_BrickGrid *grid, const C_Rectangle *rectangle)
+{
+    assert(grid != NULL);
+    assert(rectangle != NULL);
+
+    size_t first_column = 0u;
+    size_t end_column = 0u;
+    intersecting_range(
+        grid->origin.x,
+        grid->column_pitch,
+        grid->brick_width,
+        grid->columns,
+        rectangle->position.x,
+        rectangle->width,
+        &first_column,
+        &end_column);
+
+    if (first_column == end_column)
+    {
+        return 0u;
+    }
+
+    size_t first_row = 0u;
+    size_t end_row = 0u;
+    intersecting_range(
+        grid->origin.y,
+        grid->row_pitch,
+        grid->brick_height,
+        grid->rows,
+        rectangle->position.y,
+        rectangle->height,
+        &first_row,
+        &end_row);
+
+    // mask with a bit set for each column intersected
+    const size_t column_count = end_column - first_column;
+    const uint64_t column_mask =
+        ((column_count == C_BRICK_GRID_MAX_COLUMNS) ? ~UINT64_C(0) : ((UINT64_C(1) << column_count) - 1u))
+        << first_column;
+
+    size_t removed = 0u;
+
+    for (size_t row = first_row; row < end_row; ++row)
+    {
+        const uint64_t hits = grid->row_masks[row] & column_mask;
+        removed += c_count_set_bits(hits);
+        grid->row_masks[row] &= ~hits;
+    }
+
+    return removed;
+}
+
+C_Rectangle c_brick_grid_brick(const C_BrickGrid *grid, size_t column, size_t row)
+{
+    assert(grid != NULL);
+    assert(column < grid->columns);
+    assert(row < grid->rows);
+
+    return c_rectangle_create_xy(
+        grid->origin.x + ((C_Scalar)column * grid->column_pitch),
+        grid->origin.y + ((C_Scalar)row * grid->row_pitch),
+        grid->brick_width,
+        grid->brick_height);
+}
@@ -0,0 +1,137 @@
+////////////////////////////////////////////////////////////////////////////////
+//         Distributed under the Boost Software License, Version 1.0.         //
+//            (See accompanying file LICENSE or copy at                       //
+//                 https://www.boost.org/LICENSE_1_0.txt)                     //
+////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "c_rectangle.h"
+#include "c_scalar.h"
+#include "c_vector2.h"
+
+/**
+ * A BrickGrid stores bricks laid out on a regular grid as a bitboard, one 64 bit mask of live bricks per row. All
+ * bricks in a row share a colour.
+ *
+ * Querying a rectangle converts it to the range of rows and columns it overlaps, so the cost depends on the number of
+ * rows touched rather than the number of bricks.
+ */
+
+/**
+ * Maximum number of columns, one per bit in a row mask.
+ */
+#define C_BRICK_GRID_MAX_COLUMNS 64u
+
+/**
+ * Maximum number of rows.
+ */
+#define C_BRICK_GRID_MAX_ROWS 64u
+
+/**
+ * Struct for brick grid data. Deliberately public.
+ */
+typedef struct C_BrickGrid
+{
+    C_Vector2 origin;
+    C_Scalar brick_width;
+    C_Scalar brick_height;
+    C_Scalar column_pitch;
+    C_Scalar row_pitch;
+    size_t columns;
+    size_t rows;
+    uint64_t row_masks[C_BRICK_GRID_MAX_ROWS];
+    uint8_t r[C_BRICK_GRID_MAX_ROWS];
+    uint8_t g[C_BRICK_GRID_MAX_ROWS];
+    uint8_t b[C_BRICK_GRID_MAX_ROWS];
+} C_BrickGrid;
+
+/**
+ * Create a new BrickGrid with no live bricks.
+ *
+ * @param origin
+ *   Position of the upper left corner of the first brick.
+ *
+ * @param brick_width
+ *   Width of each brick.
+ *
+ * @param brick_height
+ *   Height of each brick.
+ *
+ * @param column_pitch
+ *   Distance between the left edges of adjacent columns, must be at least brick_width.
+ *
+ * @param row_pitch
+ *   Distance between the top edges of adjacent rows, must be at least brick_height.
+ *
+ * @param columns
+ *   Number of columns, at most C_BRICK_GRID_MAX_COLUMNS.
+ *
+ * @param rows
+ *   Number of rows, at most C_BRICK_GRID_MAX_ROWS.
+ *
+ * @returns
+ *   BrickGrid constructed with supplied values.
+ */
+C_BrickGrid c_brick_grid_create(
+    const C_Vector2 *origin,
+    C_Scalar brick_width,
+    C_Scalar brick_height,
+    C_Scalar column_pitch,
+    C_Scalar row_pitch,
+    size_t columns,
+    size_t rows);
+
+/**
+ * Make every brick in a row live.
+ *
+ * @param grid
+ *   Grid to fill row in.
+ *
+ * @param row
+ *   Index of row.
+ *
+ * @param r
+ *   Red component of brick colour.
+ *
+ * @param g
+ *   Green component of brick colour.
+ *
+ * @param b
+ *  Blue component of brick colour.
+ */
+void c_brick_grid_fill_row(C_BrickGrid *grid, size_t row, uint8_t r, uint8_t g, uint8_t b);
+
+/**
+ * Remove every live brick a rectangle intersects with.
+ *
+ * @param grid
+ *   Grid to remove bricks from.
+ *
+ * @param rectangle
+ *   Rectangle to test.
+ *
+ * @returns
+ *   Number of bricks removed.
+ */
+size_t c_brick_grid_remove_intersecting(C_BrickGrid *grid, const C_Rectangle *rectangle);
+
+/**
+ * Get the rectangle covered by a brick.
+ *
+ * @param grid
+ *   Grid brick is in.
+ *
+ * @param column
+ *   Column of brick.
+ *
+ * @param row
+ *   Row of brick.
+ *
+ * @returns
+ *   Rectangle for brick.
+ */
+C_Rectangle c_brick_grid_brick(const C_BrickGrid *grid, size_t column, size_t row);
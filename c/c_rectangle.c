@@ -9,14 +9,15 @@
 #include <assert.h>
 #include <stdio.h>
 
+#include "c_scalar.h"
 #include "c_vector2.h"
 
-C_Rectangle c_rectangle_create(const C_Vector2 *position, float width, float height)
+C_Rectangle c_rectangle_create(const C_Vector2 *position, C_Scalar width, C_Scalar height)
 {
     return c_rectangle_create_xy(position->x, position->y, width, height);
 }
 
-C_Rectangle c_rectangle_create_xy(float x, float y, float width, float height)
+C_Rectangle c_rectangle_create_xy(C_Scalar x, C_Scalar y, C_Scalar width, C_Scalar height)
 {
     C_Rectangle rect = {.position = {.x = x, .y = y}, .width = width, .height = height};
     return rect;
@@ -27,7 +28,7 @@ void c_rectangle_translate(C_Rectangle *rectangle, const C_Vector2 *translation)
     c_vector2_add(&rectangle->position, translation);
 }
 
-void c_rectangle_translate_xy(C_Rectangle *rectangle, float x, float y)
+void c_rectangle_translate_xy(C_Rectangle *rectangle, C_Scalar x, C_Scalar y)
 {
     c_vector2_add_xy(&rectangle->position, x, y);
 }
@@ -37,7 +38,7 @@ void c_rectangle_set_position(C_Rectangle *rectangle, const C_Vector2 *position)
     rectangle->position = *position;
 }
 
-void c_rectangle_set_position_xy(C_Rectangle *rectangle, float x, float y)
+void c_rectangle_set_position_xy(C_Rectangle *rectangle, C_Scalar x, C_Scalar y)
 {
     rectangle->position.x = x;
     rectangle->position.y = y;
@@ -47,8 +48,8 @@ void c_rectangle_print(const C_Rectangle *rectangle)
 {
     printf(
         "{ x: %f, y: %f, w: %f, h: %f }\n",
-        rectangle->position.x,
-        rectangle->position.y,
-        rectangle->width,
-        rectangle->height);
+        C_SCALAR_TO_FLOAT(rectangle->position.x),
+        C_SCALAR_TO_FLOAT(rectangle->position.y),
+        C_SCALAR_TO_FLOAT(rectangle->width),
+        C_SCALAR_TO_FLOAT(rectangle->height));
 }
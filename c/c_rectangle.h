@@ -6,6 +6,7 @@
 
 #pragma once
 
+#include "c_scalar.h"
 #include "c_vector2.h"
 
 /**
@@ -19,8 +20,8 @@
 typedef struct C_Rectangle
 {
     C_Vector2 position;
-    float width;
-    float height;
+    C_Scalar width;
+    C_Scalar height;
 } C_Rectangle;
 
 /**
@@ -38,7 +39,7 @@ typedef struct C_Rectangle
  * @returns
  *   Rectangle constructed with supplied values.
  */
-C_Rectangle c_rectangle_create(const C_Vector2 *position, float width, float height);
+C_Rectangle c_rectangle_create(const C_Vector2 *position, C_Scalar width, C_Scalar height);
 
 /**
  * Create a new Rectangle.
@@ -58,7 +59,7 @@ C_Rectangle c_rectangle_create(const C_Vector2 *position, float width, float hei
  * @returns
  *   Rectangle constructed with supplied values.
  */
-C_Rectangle c_rectangle_create_xy(float x, float y, float width, float height);
+C_Rectangle c_rectangle_create_xy(C_Scalar x, C_Scalar y, C_Scalar width, C_Scalar height);
 
 /**
  * Translate the position of a rectangle.
@@ -83,7 +84,7 @@ void c_rectangle_translate(C_Rectangle *rectangle, const C_Vector2 *translation)
  * @param y
  *   Amount to move along y axis.
  */
-void c_rectangle_translate_xy(C_Rectangle *rectangle, float x, float y);
+void c_rectangle_translate_xy(C_Rectangle *rectangle, C_Scalar x, C_Scalar y);
 
 /**
  * Set the position of a rectangle.
@@ -108,7 +109,7 @@ void c_rectangle_set_position(C_Rectangle *rectangle, const C_Vector2 *position)
  * @param y
  *   Y coordinate of new position.
  */
-void c_rectangle_set_position_xy(C_Rectangle *rectangle, float x, float y);
+void c_rectangle_set_position_xy(C_Rectangle *rectangle, C_Scalar x, C_Scalar y);
 
 /**
  * Print rectangle to stdout.
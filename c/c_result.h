@@ -30,7 +30,5 @@ typedef enum C_Result
     C_FAILED_TO_SET_RENDER_COLOUR,
     C_FAILED_TO_DRAW_FILLED_RECT,
 
-    C_FAILED_TO_ALLOCATE_LIST,
-    C_FAILED_TO_ALLOCATE_NODE,
-    C_FAILED_TO_ALLOCATE_ITERATOR,
+    C_FAILED_TO_ALLOCATE_VECTOR,
 } C_Result;
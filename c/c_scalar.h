@@ -0,0 +1,72 @@
+////////////////////////////////////////////////////////////////////////////////
+//         Distributed under the Boost Software License, Version 1.0.         //
+//            (See accompanying file LICENSE or copy at                       //
+//                 https://www.boost.org/LICENSE_1_0.txt)                     //
+////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <stdint.h>
+
+/**
+ * A Scalar is the type used for all positions and sizes in the simulation.
+ *
+ * By default this is a float. If C_GAME_FIXED_POINT is defined it is instead a Q16.16 fixed point integer, so the
+ * simulation only uses integer arithmetic and gives bit identical results regardless of compiler, flags or machine.
+ *
+ * Scalars can be added, subtracted, negated and compared directly in either mode. Dividing one scalar by another gives
+ * a plain (unscaled) ratio, and multiplying a scalar by a plain integer gives a scalar.
+ */
+
+#if defined(C_GAME_FIXED_POINT)
+
+/**
+ * Q16.16 fixed point value.
+ */
+typedef int32_t C_Scalar;
+
+/**
+ * Number of fractional bits in a scalar.
+ */
+#define C_SCALAR_FRACTION_BITS 16
+
+/**
+ * Convert a number to a scalar, rounding to the nearest representable value. This is a constant expression when given
+ * a constant.
+ */
+#define C_SCALAR(X)                                                                                                    \
+    ((C_Scalar)(((X) * (double)(1 << C_SCALAR_FRACTION_BITS)) + (((X) < 0) ? -0.5 : 0.5)))
+
+/**
+ * Convert a scalar to an int, rounding down.
+ */
+#define C_SCALAR_TO_INT(X) ((int)((X) >> C_SCALAR_FRACTION_BITS))
+
+/**
+ * Convert a scalar to a float, for display.
+ */
+#define C_SCALAR_TO_FLOAT(X) ((float)(X) / (float)(1 << C_SCALAR_FRACTION_BITS))
+
+#else
+
+/**
+ * Floating point value.
+ */
+typedef float C_Scalar;
+
+/**
+ * Convert a number to a scalar.
+ */
+#define C_SCALAR(X) ((C_Scalar)(X))
+
+/**
+ * Convert a scalar to an int, rounding towards zero.
+ */
+#define C_SCALAR_TO_INT(X) ((int)(X))
+
+/**
+ * Convert a scalar to a float, for display.
+ */
+#define C_SCALAR_TO_FLOAT(X) ((float)(X))
+
+#endif
@@ -0,0 +1,147 @@
+////////////////////////////////////////////////////////////////////////////////
+//         Distributed under the Boost Software License, Version 1.0.         //
+//            (See accompanying file LICENSE or copy at                       //
+//                 https://www.boost.org/LICENSE_1_0.txt)                     //
+////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <assert.h>
+#include <stddef.h>
+#include <stdlib.h>
+
+#include "c_result.h"
+
+/**
+ * Growable array which stores its elements contiguously and by value.
+ *
+ * A vector is generated for a specific element type with two macros, C_VECTOR_DECLARE (for the struct and function
+ * declarations) and C_VECTOR_DEFINE (for the function definitions, which should appear once). For example:
+ *
+ *   C_VECTOR_DECLARE(C_IntVector, c_int_vector, int)
+ *   C_VECTOR_DEFINE(C_IntVector, c_int_vector, int)
+ *
+ * Generates the type C_IntVector along with functions c_int_vector_create, c_int_vector_destroy, etc.
+ *
+ * The struct is deliberately public, elements can be accessed directly through data[0] to data[size - 1].
+ */
+
+/**
+ * Smallest capacity allocated when a vector first grows.
+ */
+#define C_VECTOR_MIN_CAPACITY 8u
+
+/**
+ * Declare a vector type and its functions.
+ *
+ * @param TYPE
+ *   Name of vector type.
+ *
+ * @param PREFIX
+ *   Prefix for function names.
+ *
+ * @param ELEMENT
+ *   Type of element to store.
+ */
+#define C_VECTOR_DECLARE(TYPE, PREFIX, ELEMENT)                                                                        \
+    typedef struct TYPE                                                                                                \
+    {                                                                                                                  \
+        ELEMENT *data;                                                                                                 \
+        size_t size;                                                                                                   \
+        size_t capacity;                                                                                               \
+    } TYPE;                                                                                                            \
+                                                                                                                       \
+    /* Create a new empty vector, this does not allocate. */                                                           \
+    TYPE PREFIX##_create(void);                                                                                        \
+                                                                                                                       \
+    /* Destroy a vector, releasing its elements. */                                                                    \
+    void PREFIX##_destroy(TYPE *vector);                                                                               \
+                                                                                                                       \
+    /* Ensure a vector can hold at least capacity elements without reallocating. */                                    \
+    C_Result PREFIX##_reserve(TYPE *vector, size_t capacity);                                                          \
+                                                                                                                       \
+    /* Copy a value to the end of a vector, amortised O(1). */                                                         \
+    C_Result PREFIX##_push_back(TYPE *vector, const ELEMENT *value);                                                   \
+                                                                                                                       \
+    /* Remove an element in O(1) by moving the last element into its place, this does not preserve order. */          \
+    void PREFIX##_swap_remove(TYPE *vector, size_t index);
+
+/**
+ * Define the functions for a vector type previously declared with C_VECTOR_DECLARE.
+ *
+ * @param TYPE
+ *   Name of vector type.
+ *
+ * @param PREFIX
+ *   Prefix for function names.
+ *
+ * @param ELEMENT
+ *   Type of element to store.
+ */
+#define C_VECTOR_DEFINE(TYPE, PREFIX, ELEMENT)                                                                         \
+    TYPE PREFIX##_create(void)                                                                                         \
+    {                                                                                                                  \
+        return (TYPE){.data = NULL, .size = 0u, .capacity = 0u};                                                       \
+    }                                                                                                                  \
+                                                                                                                       \
+    void PREFIX##_destroy(TYPE *vector)                                                                                \
+    {                                                                                                                  \
+        assert(vector != NULL);                                                                                        \
+                                                                                                                       \
+        free(vector->data);                                                                                            \
+        *vector = PREFIX##_create();                                                                                   \
+    }                                                                                                                  \
+                                                                                                                       \
+    C_Result PREFIX##_reserve(TYPE *vector, size_t capacity)                                                           \
+    {                                                                                                                  \
+        assert(vector != NULL);                                                                                        \
+                                                                                                                       \
+        if (capacity <= vector->capacity)                                                                              \
+        {                                                                                                              \
+            return C_SUCCESS;                                                                                          \
+        }                                                                                                              \
+                                                                                                                       \
+        ELEMENT *new_data = (ELEMENT *)realloc(vector->data, capacity * sizeof(ELEMENT));                              \
+        if (new_data == NULL)                                                                                          \
+        {                                                                                                              \
+            return C_FAILED_TO_ALLOCATE_VECTOR;                                                                        \
+        }                                                                                                              \
+                                                                                                                       \
+        vector->data = new_data;                                                                                       \
+        vector->capacity = capacity;                                                                                   \
+                                                                                                                       \
+        return C_SUCCESS;                                                                                              \
+    }                                                                                                                  \
+                                                                                                                       \
+    C_Result PREFIX##_push_back(TYPE *vector, const ELEMENT *value)                                                    \
+    {                                                                                                                  \
+        assert(vector != NULL);                                                                                        \
+        assert(value != NULL);                                                                                         \
+                                                                                                                       \
+        /* double the capacity when full so pushing is amortised O(1) */                                               \
+        if (vector->size == vector->capacity)                                                                          \
+        {                                                                                                              \
+            const size_t new_capacity =                                                                                \
+                (vector->capacity < C_VECTOR_MIN_CAPACITY) ? C_VECTOR_MIN_CAPACITY : vector->capacity * 2u;            \
+                                                                                                                       \
+            const C_Result result = PREFIX##_reserve(vector, new_capacity);                                            \
+            if (result != C_SUCCESS)                                                                                   \
+            {                                                                                                          \
+                return result;                                                                                         \
+            }                                                                                                          \
+        }                                                                                                              \
+                                                                                                                       \
+        vector->data[vector->size] = *value;                                                                           \
+        ++vector->size;                                                                                                \
+                                                                                                                       \
+        return C_SUCCESS;                                                                                              \
+    }                                                                                                                  \
+                                                                                                                       \
+    void PREFIX##_swap_remove(TYPE *vector, size_t index)                                                              \
+    {                                                                                                                  \
+        assert(vector != NULL);                                                                                        \
+        assert(index < vector->size);                                                                                  \
+                                                                                                                       \
+        --vector->size;                                                                                                \
+        vector->data[index] = vector->data[vector->size];                                                              \
+    }
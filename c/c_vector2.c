@@ -9,12 +9,14 @@
 #include <assert.h>
 #include <stdio.h>
 
+#include "c_scalar.h"
+
 C_Vector2 c_vector2_create()
 {
-    return c_vector2_create_xy(0.0f, 0.0f);
+    return c_vector2_create_xy(C_SCALAR(0), C_SCALAR(0));
 }
 
-C_Vector2 c_vector2_create_xy(float x, float y)
+C_Vector2 c_vector2_create_xy(C_Scalar x, C_Scalar y)
 {
     C_Vector2 vec = {.x = x, .y = y};
     return vec;
@@ -29,7 +31,7 @@ void c_vector2_add(C_Vector2 *vec1, const C_Vector2 *vec2)
     vec1->y += vec2->y;
 }
 
-void c_vector2_add_xy(C_Vector2 *vec, float x, float y)
+void c_vector2_add_xy(C_Vector2 *vec, C_Scalar x, C_Scalar y)
 {
     assert(vec != NULL);
 
@@ -41,5 +43,5 @@ void c_vector2_print(const C_Vector2 *vec)
 {
     assert(vec != NULL);
 
-    printf("{ x: %f, y: %f }\n", vec->x, vec->y);
+    printf("{ x: %f, y: %f }\n", C_SCALAR_TO_FLOAT(vec->x), C_SCALAR_TO_FLOAT(vec->y));
 }
@@ -6,6 +6,8 @@
 
 #pragma once
 
+#include "c_scalar.h"
+
 /**
  * A Vector2 represents a two component (x and y) vector.
  */
@@ -15,15 +17,15 @@
  */
 typedef struct C_Vector2
 {
-    float x;
-    float y;
+    C_Scalar x;
+    C_Scalar y;
 } C_Vector2;
 
 /**
- * Create a new Vector2 with both components 0.0.
+ * Create a new Vector2 with both components 0.
  *
  * @returns
- *   Vector2 with x and y set to 0.0.
+ *   Vector2 with x and y set to 0.
  */
 C_Vector2 c_vector2_create();
 
@@ -39,7 +41,7 @@ C_Vector2 c_vector2_create();
  * @returns
  *   Vector2 with x and y set to supplied values.
  */
-C_Vector2 c_vector2_create_xy(float x, float y);
+C_Vector2 c_vector2_create_xy(C_Scalar x, C_Scalar y);
 
 /**
  * Add one vector to another.
@@ -64,7 +66,7 @@ void c_vector2_add(C_Vector2 *vec1, const C_Vector2 *vec2);
  * @param y
  *   Value to add to y component.
  */
-void c_vector2_add_xy(C_Vector2 *vec, float x, float y);
+void c_vector2_add_xy(C_Vector2 *vec, C_Scalar x, C_Scalar y);
 
 /**
  * Print vector to stdout.
@@ -15,6 +15,7 @@
 
 #include "c_key_event.h"
 #include "c_result.h"
+#include "c_scalar.h"
 
 typedef struct C_Window
 {
@@ -164,7 +165,10 @@ C_Result c_window_draw_rectangle(const C_Window *window, const C_Rectangle *rect
 
     // convert our internal rect to an SDL rect
     SDL_Rect sdl_rect = {
-        .x = rectangle->position.x, .y = rectangle->position.y, .w = rectangle->width, .h = rectangle->height};
+        .x = C_SCALAR_TO_INT(rectangle->position.x),
+        .y = C_SCALAR_TO_INT(rectangle->position.y),
+        .w = C_SCALAR_TO_INT(rectangle->width),
+        .h = C_SCALAR_TO_INT(rectangle->height)};
 
     // set the draw colour
     if (SDL_SetRenderDrawColor(window->renderer, r, g, b, 0xff) != 0)
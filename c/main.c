@@ -11,10 +11,16 @@
 #include <stdlib.h>
 
 #include "c_key_event.h"
-#include "c_list.h"
 #include "c_rectangle.h"
+#include "c_scalar.h"
+#include "c_vector.h"
 #include "c_window.h"
 
+#if defined(C_GAME_BITBOARD)
+#include "c_bits.h"
+#include "c_brick_grid.h"
+#endif
+
 /**
  * Struct encapsulating the data for a renderable entity.
  */
@@ -26,6 +32,28 @@ typedef struct Entity
     uint8_t b;
 } Entity;
 
+#if defined(C_GAME_BITBOARD)
+
+/**
+ * Bricks are stored as a bitboard, one bit per brick.
+ */
+typedef C_BrickGrid Bricks;
+
+#else
+
+/**
+ * Contiguous array of entities.
+ */
+C_VECTOR_DECLARE(EntityVector, entity_vector, Entity)
+C_VECTOR_DEFINE(EntityVector, entity_vector, Entity)
+
+/**
+ * Bricks are stored as an array of entities.
+ */
+typedef EntityVector Bricks;
+
+#endif
+
 /**
  * Helper macro for checking if a value is C_SUCCESS. If not it prints a supplied messaged and exits.
  */
@@ -41,42 +69,19 @@ typedef struct Entity
     } while (false)
 
 /**
- * Helper function to create a row of ten bricks.
+ * Helper function to draw an entity.
  *
- * @param entities
- *   List to store entities in.
+ * @param window
+ *   Window to draw to.
  *
- * @param y
- *   Y coordinate of row.
- *
- * @param r
- *   Red component of brick colour.
- *
- * @param g
- *   Green component of brick colour.
- *
- * @param b
- *  Blue component of brick colour.
+ * @param entity
+ *   Entity to draw.
  */
-static void create_brick_row(C_List *entities, float y, uint8_t r, uint8_t g, uint8_t b)
+static void draw_entity(C_Window *window, const Entity *entity)
 {
-    float x = 20.0f;
-
-    for (int i = 0; i < 10; ++i)
-    {
-        Entity *e = (Entity *)calloc(sizeof(Entity), 1u);
-        e->rectangle.position.x = x;
-        e->rectangle.position.y = y;
-        e->rectangle.width = 58.0f;
-        e->rectangle.height = 20.0f;
-        e->r = r;
-        e->g = g;
-        e->b = b;
-
-        CHECK_SUCCESS(c_list_push_back_dtor(entities, e, &free), "failed to add brick");
-
-        x += 78.0f;
-    }
+    CHECK_SUCCESS(
+        c_window_draw_rectangle(window, &entity->rectangle, entity->r, entity->g, entity->b),
+        "failed to render entity");
 }
 
 /**
@@ -93,14 +98,14 @@ static void update_ball(Entity *ball, C_Vector2 *ball_velocity)
     c_vector2_add(&ball->rectangle.position, ball_velocity);
 
     // if ball does out of the screen then invert the y velocity
-    if ((ball->rectangle.position.y < 0.0f) || (ball->rectangle.position.y > 800.0f))
+    if ((ball->rectangle.position.y < C_SCALAR(0.0)) || (ball->rectangle.position.y > C_SCALAR(800.0)))
     {
-        ball_velocity->y *= -1.0f;
+        ball_velocity->y = -ball_velocity->y;
     }
 
-    if ((ball->rectangle.position.x < 0.0f) || (ball->rectangle.position.x > 800.0f))
+    if ((ball->rectangle.position.x < C_SCALAR(0.0)) || (ball->rectangle.position.x > C_SCALAR(800.0)))
     {
-        ball_velocity->x *= -1.0f;
+        ball_velocity->x = -ball_velocity->x;
     }
 }
 
@@ -125,69 +130,240 @@ bool static check_collision(const Entity *entity1, const Entity *entity2)
         (entity1->rectangle.height + entity1->rectangle.position.y > entity2->rectangle.position.y));
 }
 
+#if defined(C_GAME_BITBOARD)
+
 /**
- * Helper function to handle collisions between the ball and other entities.
+ * Helper function to create the initial bricks.
  *
- * @param entities
- *   List of all entities.
+ * @param bricks
+ *   Out parameter for created bricks.
+ */
+static void create_bricks(Bricks *bricks)
+{
+    const C_Vector2 origin = c_vector2_create_xy(C_SCALAR(20.0), C_SCALAR(50.0));
+    *bricks = c_brick_grid_create(&origin, C_SCALAR(58.0), C_SCALAR(20.0), C_SCALAR(78.0), C_SCALAR(30.0), 10u, 6u);
+
+    c_brick_grid_fill_row(bricks, 0u, 0xff, 0x00, 0x00);
+    c_brick_grid_fill_row(bricks, 1u, 0xff, 0x00, 0x00);
+    c_brick_grid_fill_row(bricks, 2u, 0xff, 0xa5, 0x00);
+    c_brick_grid_fill_row(bricks, 3u, 0xff, 0xa5, 0x00);
+    c_brick_grid_fill_row(bricks, 4u, 0x00, 0xff, 0x00);
+    c_brick_grid_fill_row(bricks, 5u, 0x00, 0xff, 0x00);
+}
+
+/**
+ * Helper function to destroy bricks.
+ *
+ * @param bricks
+ *   Bricks to destroy.
+ */
+static void destroy_bricks(Bricks *bricks)
+{
+    // the grid doesn't own any memory
+    (void)bricks;
+}
+
+/**
+ * Helper function to remove every brick the ball intersects with.
+ *
+ * @param bricks
+ *   All remaining bricks.
  *
  * @param ball
  *   Ball entity.
  *
- * @param ball_velocity
- *   The velocity of the ball.
+ * @returns
+ *   True if any bricks were removed, false otherwise.
+ */
+static bool remove_hit_bricks(Bricks *bricks, const Entity *ball)
+{
+    return c_brick_grid_remove_intersecting(bricks, &ball->rectangle) > 0u;
+}
+
+/**
+ * Helper function to draw all remaining bricks.
  *
- * @param paddle
- *   Paddle entity.
+ * @param window
+ *   Window to draw to.
+ *
+ * @param bricks
+ *   Bricks to draw.
  */
-static void handle_collisions(C_List *entities, Entity *ball, C_Vector2 *ball_velocity, const Entity *paddle)
+static void draw_bricks(C_Window *window, const Bricks *bricks)
 {
-    // keep iterator scoped so we can't use it after it's been destroyed
+    for (size_t row = 0u; row < bricks->rows; ++row)
     {
-        C_ListIter *iter;
-        CHECK_SUCCESS(c_list_iterator_create(entities, &iter), "could not create iterator");
+        // visit each live brick by repeatedly taking the lowest set bit
+        uint64_t live = bricks->row_masks[row];
+        while (live != 0u)
+        {
+            const C_Rectangle rectangle = c_brick_grid_brick(bricks, c_count_trailing_zeros(live), row);
+            CHECK_SUCCESS(
+                c_window_draw_rectangle(window, &rectangle, bricks->r[row], bricks->g[row], bricks->b[row]),
+                "failed to render brick");
 
-        // move past ball and paddle
-        c_list_iterator_advance(&iter);
-        c_list_iterator_advance(&iter);
+            live &= live - 1u;
+        }
+    }
+}
 
-        // see if the ball intersects with any bricks
-        while (!c_list_iterator_at_end(iter))
-        {
-            Entity *block = (Entity *)c_list_iterator_value(iter);
+#else
 
-            if (check_collision(ball, block))
-            {
-                c_list_remove(entities, iter);
-                ball_velocity->y *= -1.0f;
+/**
+ * Helper function to create a row of ten bricks.
+ *
+ * @param bricks
+ *   Vector to store bricks in.
+ *
+ * @param y
+ *   Y coordinate of row.
+ *
+ * @param r
+ *   Red component of brick colour.
+ *
+ * @param g
+ *   Green component of brick colour.
+ *
+ * @param b
+ *  Blue component of brick colour.
+ */
+static void create_brick_row(EntityVector *bricks, C_Scalar y, uint8_t r, uint8_t g, uint8_t b)
+{
+    C_Scalar x = C_SCALAR(20.0);
 
-                // if we modify the list this will invalidate the iterator, so stop
-                break;
-            }
+    for (int i = 0; i < 10; ++i)
+    {
+        const Entity brick = {
+            .rectangle = c_rectangle_create_xy(x, y, C_SCALAR(58.0), C_SCALAR(20.0)), .r = r, .g = g, .b = b};
+        CHECK_SUCCESS(entity_vector_push_back(bricks, &brick), "failed to add brick");
 
-            c_list_iterator_advance(&iter);
+        x += C_SCALAR(78.0);
+    }
+}
+
+/**
+ * Helper function to create the initial bricks.
+ *
+ * @param bricks
+ *   Out parameter for created bricks.
+ */
+static void create_bricks(Bricks *bricks)
+{
+    // bricks are stored inline, reserve space for them all up front
+    *bricks = entity_vector_create();
+    CHECK_SUCCESS(entity_vector_reserve(bricks, 60u), "failed to reserve bricks");
+
+    create_brick_row(bricks, C_SCALAR(50.0), 0xff, 0x00, 0x00);
+    create_brick_row(bricks, C_SCALAR(80.0), 0xff, 0x00, 0x00);
+    create_brick_row(bricks, C_SCALAR(110.0), 0xff, 0xa5, 0x00);
+    create_brick_row(bricks, C_SCALAR(140.0), 0xff, 0xa5, 0x00);
+    create_brick_row(bricks, C_SCALAR(170.0), 0x00, 0xff, 0x00);
+    create_brick_row(bricks, C_SCALAR(200.0), 0x00, 0xff, 0x00);
+}
+
+/**
+ * Helper function to destroy bricks.
+ *
+ * @param bricks
+ *   Bricks to destroy.
+ */
+static void destroy_bricks(Bricks *bricks)
+{
+    entity_vector_destroy(bricks);
+}
+
+/**
+ * Helper function to remove every brick the ball intersects with.
+ *
+ * @param bricks
+ *   All remaining bricks.
+ *
+ * @param ball
+ *   Ball entity.
+ *
+ * @returns
+ *   True if any bricks were removed, false otherwise.
+ */
+static bool remove_hit_bricks(Bricks *bricks, const Entity *ball)
+{
+    // removing moves the last brick into this slot so only advance on a miss
+    bool hit = false;
+    size_t i = 0u;
+    while (i < bricks->size)
+    {
+        if (check_collision(ball, &bricks->data[i]))
+        {
+            entity_vector_swap_remove(bricks, i);
+            hit = true;
         }
+        else
+        {
+            ++i;
+        }
+    }
+
+    return hit;
+}
+
+/**
+ * Helper function to draw all remaining bricks.
+ *
+ * @param window
+ *   Window to draw to.
+ *
+ * @param bricks
+ *   Bricks to draw.
+ */
+static void draw_bricks(C_Window *window, const Bricks *bricks)
+{
+    for (size_t i = 0u; i < bricks->size; ++i)
+    {
+        draw_entity(window, &bricks->data[i]);
+    }
+}
+
+#endif
 
-        c_list_iterator_destroy(iter);
+/**
+ * Helper function to handle collisions between the ball and other entities.
+ *
+ * @param bricks
+ *   All remaining bricks.
+ *
+ * @param ball
+ *   Ball entity.
+ *
+ * @param ball_velocity
+ *   The velocity of the ball.
+ *
+ * @param paddle
+ *   Paddle entity.
+ */
+static void handle_collisions(Bricks *bricks, Entity *ball, C_Vector2 *ball_velocity, const Entity *paddle)
+{
+    // bounce once however many bricks were hit
+    if (remove_hit_bricks(bricks, ball))
+    {
+        ball_velocity->y = -ball_velocity->y;
     }
 
     // handle ball - paddle collision
     if (check_collision(ball, paddle))
     {
-        if (ball->rectangle.position.x < paddle->rectangle.position.x + 6.0f)
+        if (ball->rectangle.position.x < paddle->rectangle.position.x + C_SCALAR(6.0))
         {
-            ball_velocity->x = -0.7f;
-            ball_velocity->y = -0.7f;
+            ball_velocity->x = C_SCALAR(-0.7);
+            ball_velocity->y = C_SCALAR(-0.7);
         }
-        else if (ball->rectangle.position.x < paddle->rectangle.position.x + 14.0f)
+        else if (ball->rectangle.position.x < paddle->rectangle.position.x + C_SCALAR(14.0))
         {
-            ball_velocity->x = 0.0f;
-            ball_velocity->y = -1.0f;
+            ball_velocity->x = C_SCALAR(0.0);
+            ball_velocity->y = C_SCALAR(-1.0);
         }
         else
         {
-            ball_velocity->x = 0.7f;
-            ball_velocity->y = -0.7f;
+            ball_velocity->x = C_SCALAR(0.7);
+            ball_velocity->y = C_SCALAR(-0.7);
         }
     }
 }
@@ -197,27 +373,21 @@ int main()
     printf("hello world\n");
 
     Entity paddle = {
-        .rectangle = c_rectangle_create_xy(300.0f, 780.0f, 300.0f, 20.0f), .r = 0xff, .g = 0xff, .b = 0xff};
-    Entity ball = {.rectangle = c_rectangle_create_xy(420.0f, 400.0f, 10.0f, 10.0f), .r = 0xff, .g = 0xff, .b = 0xff};
+        .rectangle = c_rectangle_create_xy(C_SCALAR(300.0), C_SCALAR(780.0), C_SCALAR(300.0), C_SCALAR(20.0)),
+        .r = 0xff,
+        .g = 0xff,
+        .b = 0xff};
+    Entity ball = {
+        .rectangle = c_rectangle_create_xy(C_SCALAR(420.0), C_SCALAR(400.0), C_SCALAR(10.0), C_SCALAR(10.0)),
+        .r = 0xff,
+        .g = 0xff,
+        .b = 0xff};
 
     C_Vector2 paddle_velocity = c_vector2_create();
-    C_Vector2 ball_velocity = c_vector2_create_xy(0.0f, 0.5f);
-
-    C_List *entities = NULL;
-    CHECK_SUCCESS(c_list_create(&entities), "failed to create entity list");
-
-    CHECK_SUCCESS(c_list_push_back(entities, &paddle), "failed to add paddle to list");
-    CHECK_SUCCESS(c_list_push_back(entities, &ball), "failed to add ball to list");
-
-    create_brick_row(entities, 50.0f, 0xff, 0x00, 0x00);
-    create_brick_row(entities, 80.0f, 0xff, 0x00, 0x00);
-    create_brick_row(entities, 110.0f, 0xff, 0xa5, 0x00);
-    create_brick_row(entities, 140.0f, 0xff, 0xa5, 0x00);
-    create_brick_row(entities, 170.0f, 0x00, 0xff, 0x00);
-    create_brick_row(entities, 200.0f, 0x00, 0xff, 0x00);
+    C_Vector2 ball_velocity = c_vector2_create_xy(C_SCALAR(0.0), C_SCALAR(0.5));
 
-    C_ListIter *iter = NULL;
-    CHECK_SUCCESS(c_list_iterator_create(entities, &iter), "failed to get entity iterator");
+    Bricks bricks;
+    create_bricks(&bricks);
 
     // create window
     C_Window *window;
@@ -226,7 +396,7 @@ int main()
     C_KeyEvent event;
     bool running = true;
 
-    const float paddle_speed = 1.0f;
+    const C_Scalar paddle_speed = C_SCALAR(1.0);
     bool left_press = false;
     bool right_press = false;
 
@@ -264,7 +434,7 @@ int main()
 
         if ((left_press && right_press) || (!left_press && !right_press))
         {
-            paddle_velocity.x = 0.0f;
+            paddle_velocity.x = C_SCALAR(0.0);
         }
         else if (left_press)
         {
@@ -277,29 +447,21 @@ int main()
 
         c_vector2_add(&paddle.rectangle.position, &paddle_velocity);
         update_ball(&ball, &ball_velocity);
-        handle_collisions(entities, &ball, &ball_velocity, &paddle);
-
-        // reset iterator as we may have modified the list and we will want to start from the beginning anyway
-        c_list_iterator_reset(entities, &iter);
+        handle_collisions(&bricks, &ball, &ball_velocity, &paddle);
 
         // render our scene
 
         CHECK_SUCCESS(c_window_pre_render(window), "pre render failed");
 
-        while (!c_list_iterator_at_end(iter))
-        {
-            Entity *entity = (Entity *)c_list_iterator_value(iter);
-            CHECK_SUCCESS(
-                c_window_draw_rectangle(window, &entity->rectangle, entity->r, entity->g, entity->b),
-                "failed to render entity");
+        draw_entity(window, &paddle);
+        draw_entity(window, &ball);
 
-            c_list_iterator_advance(&iter);
-        }
+        draw_bricks(window, &bricks);
 
         c_window_post_render(window);
     }
 
-    c_list_iterator_destroy(iter);
+    destroy_bricks(&bricks);
     c_window_destroy(window);
 
     printf("goodbye\n");
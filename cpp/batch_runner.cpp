@@ -0,0 +1,227 @@
+////////////////////////////////////////////////////////////////////////////////
+//         Distributed under the Boost Software License, Version 1.0.         //
+//            (See accompanying file LICENSE or copy at                       //
+//                 https://www.boost.org/LICENSE_1_0.txt)                     //
+////////////////////////////////////////////////////////////////////////////////
+
+#include <algorithm>
+#include <charconv>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <fstream>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <thread>
+#include <vector>
+
+#include "input_script.h"
+#include "profiler.h"
+#include "simulation.h"
+#include "work_stealing_pool.h"
+
+namespace
+{
+
+/**
+ * Struct encapsulating a single headless game. Padded to a cache line so games stepped on different threads don't
+ * falsely share the state they write every step.
+ */
+struct alignas(64) Instance
+{
+    /** Game state. */
+    cpp::Simulation simulation;
+
+    /** Script driving the game. */
+    const cpp::InputScript *script;
+};
+
+/**
+ * Struct encapsulating the parsed command line.
+ */
+struct Options
+{
+    /** Number of threads to step games on. */
+    std::size_t threads;
+
+    /** Number of games. */
+    std::size_t instances;
+
+    /** Number of steps to run each game for. */
+    std::uint64_t steps;
+
+    /** Paths to input scripts, games are assigned them in turn. */
+    std::vector<std::string> script_paths;
+};
+
+/**
+ * Helper function to print usage.
+ */
+void print_usage()
+{
+    std::cerr << "usage: cpp_batch_runner [--threads <count>] <instances> <steps> [input script...]\n";
+}
+
+/**
+ * Helper function to parse a positive integer argument. Throws std::runtime_error if it is invalid.
+ *
+ * @param arg
+ *   Argument to parse.
+ *
+ * @returns
+ *   Parsed value.
+ */
+std::uint64_t parse_count(std::string_view arg)
+{
+    auto value = std::uint64_t{0u};
+    const auto [end, error] = std::from_chars(arg.data(), arg.data() + arg.size(), value);
+
+    if ((error != std::errc{}) || (end != arg.data() + arg.size()) || (value == 0u))
+    {
+        throw std::runtime_error{"invalid count '" + std::string{arg} + "'"};
+    }
+
+    return value;
+}
+
+/**
+ * Helper function to parse the command line. Throws std::runtime_error if it is invalid.
+ *
+ * @param argc
+ *   Number of arguments.
+ *
+ * @param argv
+ *   Arguments.
+ *
+ * @returns
+ *   Parsed options.
+ */
+Options parse_options(int argc, char **argv)
+{
+    const std::vector<std::string_view> args(argv + 1, argv + argc);
+
+    // default to one thread per core
+    Options options{
+        .threads = std::max(std::thread::hardware_concurrency(), 1u), .instances = 0u, .steps = 0u, .script_paths = {}};
+
+    auto arg = args.cbegin();
+
+    if ((arg != args.cend()) && (*arg == "--threads"))
+    {
+        if (++arg == args.cend())
+        {
+            throw std::runtime_error{"missing thread count"};
+        }
+
+        options.threads = parse_count(*arg++);
+    }
+
+    if (std::distance(arg, args.cend()) < 2)
+    {
+        throw std::runtime_error{"missing instance or step count"};
+    }
+
+    options.instances = parse_count(*arg++);
+    options.steps = parse_count(*arg++);
+    options.script_paths.assign(arg, args.cend());
+
+    return options;
+}
+
+/**
+ * Helper function to load input scripts. Throws std::runtime_error if any can't be read or parsed.
+ *
+ * @param paths
+ *   Paths of scripts to load.
+ *
+ * @returns
+ *   Loaded scripts, or a single empty script if there are no paths.
+ */
+std::vector<cpp::InputScript> load_scripts(const std::vector<std::string> &paths)
+{
+    std::vector<cpp::InputScript> scripts{};
+
+    for (const auto &path : paths)
+    {
+        std::ifstream file{path};
+        if (!file)
+        {
+            throw std::runtime_error{"failed to open " + path};
+        }
+
+        scripts.emplace_back(file);
+    }
+
+    if (scripts.empty())
+    {
+        scripts.emplace_back();
+    }
+
+    return scripts;
+}
+
+}
+
+int main(int argc, char **argv)
+{
+    try
+    {
+        const auto options = parse_options(argc, argv);
+        const auto scripts = load_scripts(options.script_paths);
+
+        // we step far faster than a frame rate, so even a clock read per scope would be significant
+        cpp::Profiler::set_enabled(false);
+
+        std::vector<Instance> instances{};
+        instances.reserve(options.instances);
+        for (auto i = std::size_t{0u}; i < options.instances; ++i)
+        {
+            instances.push_back({.simulation = {}, .script = &scripts[i % scripts.size()]});
+        }
+
+        cpp::WorkStealingPool pool{options.threads};
+
+        // each task runs one game to completion, games are independent so there is no synchronisation between steps
+        const auto start = std::chrono::steady_clock::now();
+
+        pool.parallel_for(instances.size(), [&instances, &options](std::size_t index) {
+            auto &instance = instances[index];
+            auto cursor = std::size_t{0u};
+
+            for (auto step = std::uint64_t{0u}; step < options.steps; ++step)
+            {
+                instance.simulation.step(instance.script->input(step, cursor));
+            }
+        });
+
+        const auto elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start);
+
+        // total bricks remaining is a cheap fingerprint of the results, to check runs are deterministic
+        auto bricks_remaining = std::size_t{0u};
+        for (const auto &instance : instances)
+        {
+            bricks_remaining += instance.simulation.bricks().alive_count();
+        }
+
+        const auto total_steps = static_cast<double>(options.instances) * static_cast<double>(options.steps);
+
+        std::cout << "instances: " << options.instances << "\n"
+                  << "threads: " << pool.thread_count() << "\n"
+                  << "steps per instance: " << options.steps << "\n"
+                  << "seconds: " << elapsed.count() << "\n"
+                  << "steps/sec: " << (total_steps / elapsed.count()) << "\n"
+                  << "bricks remaining: " << bricks_remaining << "\n";
+    }
+    catch (const std::exception &e)
+    {
+        std::cerr << "error: " << e.what() << "\n";
+        print_usage();
+        return 1;
+    }
+
+    return 0;
+}
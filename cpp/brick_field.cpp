@@ -0,0 +1,115 @@
+////////////////////////////////////////////////////////////////////////////////
+//         Distributed under the Boost Software License, Version 1.0.         //
+//            (See accompanying file LICENSE or copy at                       //
+//                 https://www.boost.org/LICENSE_1_0.txt)                     //
+////////////////////////////////////////////////////////////////////////////////
+
+#include "brick_field.h"
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+#include "colour.h"
+#include "rectangle.h"
+
+namespace cpp
+{
+
+std::size_t BrickField::add(const Rectangle &rectangle, const Colour &colour)
+{
+    x_.push_back(rectangle.position.x);
+    y_.push_back(rectangle.position.y);
+    width_.push_back(rectangle.width);
+    height_.push_back(rectangle.height);
+    colour_.push_back(colour);
+    alive_.push_back(1u);
+    ++alive_count_;
+
+    return x_.size() - 1u;
+}
+
+void BrickField::destroy(std::size_t index)
+{
+    assert(index < alive_.size());
+
+    if (alive_[index] != 0u)
+    {
+        alive_[index] = 0u;
+        --alive_count_;
+        destroyed_.push_back(index);
+    }
+}
+
+std::size_t BrickField::size() const
+{
+    return x_.size();
+}
+
+std::size_t BrickField::alive_count() const
+{
+    return alive_count_;
+}
+
+bool BrickField::alive(std::size_t index) const
+{
+    return alive_[index] != 0u;
+}
+
+Rectangle BrickField::rectangle(std::size_t index) const
+{
+    return {{x_[index], y_[index]}, width_[index], height_[index]};
+}
+
+std::span<const float> BrickField::x() const
+{
+    return x_;
+}
+
+std::span<const float> BrickField::y() const
+{
+    return y_;
+}
+
+std::span<const float> BrickField::width() const
+{
+    return width_;
+}
+
+std::span<const float> BrickField::height() const
+{
+    return height_;
+}
+
+std::span<const Colour> BrickField::colour() const
+{
+    return colour_;
+}
+
+std::span<const std::uint8_t> BrickField::alive_mask() const
+{
+    return alive_;
+}
+
+void BrickField::move(std::size_t from, std::size_t to)
+{
+    x_[to] = x_[from];
+    y_[to] = y_[from];
+    width_[to] = width_[from];
+    height_[to] = height_[from];
+    colour_[to] = colour_[from];
+    alive_[to] = alive_[from];
+}
+
+void BrickField::pop_back()
+{
+    x_.pop_back();
+    y_.pop_back();
+    width_.pop_back();
+    height_.pop_back();
+    colour_.pop_back();
+    alive_.pop_back();
+}
+
+}
@@ -0,0 +1,213 @@
+////////////////////////////////////////////////////////////////////////////////
+//         Distributed under the Boost Software License, Version 1.0.         //
+//            (See accompanying file LICENSE or copy at                       //
+//                 https://www.boost.org/LICENSE_1_0.txt)                     //
+////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <span>
+#include <vector>
+
+#include "colour.h"
+#include "rectangle.h"
+
+namespace cpp
+{
+
+/**
+ * BrickField stores a collection of bricks as a structure of arrays. Each brick component (x, y, width, height and
+ * colour) lives in its own contiguous array, so a pass over the bricks only pulls the components it needs through the
+ * cache.
+ *
+ * Destroying a brick doesn't remove it, instead it is marked as dead in an alive mask. This means brick indices remain
+ * stable until compact is called, at which point each destroyed brick is replaced by the last brick in the field. The
+ * cost of removal is therefore proportional to the number of destroyed bricks, not the size of the field.
+ */
+class BrickField
+{
+  public:
+    /**
+     * Add a new brick to the field.
+     *
+     * @param rectangle
+     *   Area of the brick.
+     *
+     * @param colour
+     *   Colour of the brick.
+     *
+     * @returns
+     *   Index of new brick.
+     */
+    std::size_t add(const Rectangle &rectangle, const Colour &colour);
+
+    /**
+     * Destroy a brick. Destroying an already dead brick is a no-op.
+     *
+     * @param index
+     *   Index of brick to destroy.
+     */
+    void destroy(std::size_t index);
+
+    /**
+     * Remove all destroyed bricks from the field. Each destroyed brick is swapped with the last brick, which is then
+     * popped, so this invalidates brick indices.
+     *
+     * @param on_move
+     *   Callable invoked with (old_index, new_index) every time a brick is moved to a new index.
+     */
+    template <class OnMove>
+    void compact(OnMove &&on_move)
+    {
+        // remove from the back first, that way the last brick is always alive (or is the one being removed)
+        std::ranges::sort(destroyed_, std::greater{});
+
+        for (const auto index : destroyed_)
+        {
+            const auto last = size() - 1u;
+
+            if (index != last)
+            {
+                move(last, index);
+                on_move(last, index);
+            }
+
+            pop_back();
+        }
+
+        destroyed_.clear();
+    }
+
+    /**
+     * Get the number of bricks in the field, including dead bricks.
+     *
+     * @returns
+     *   Number of bricks.
+     */
+    std::size_t size() const;
+
+    /**
+     * Get the number of bricks that are still alive.
+     *
+     * @returns
+     *   Number of alive bricks.
+     */
+    std::size_t alive_count() const;
+
+    /**
+     * Check if a brick is alive.
+     *
+     * @param index
+     *   Index of brick to check.
+     *
+     * @returns
+     *   True if brick is alive, otherwise false.
+     */
+    bool alive(std::size_t index) const;
+
+    /**
+     * Get the rectangle for a brick.
+     *
+     * @param index
+     *   Index of brick.
+     *
+     * @returns
+     *   Brick rectangle.
+     */
+    Rectangle rectangle(std::size_t index) const;
+
+    /**
+     * Get the x coordinate of all bricks.
+     *
+     * @returns
+     *   X coordinates, indexed by brick.
+     */
+    std::span<const float> x() const;
+
+    /**
+     * Get the y coordinate of all bricks.
+     *
+     * @returns
+     *   Y coordinates, indexed by brick.
+     */
+    std::span<const float> y() const;
+
+    /**
+     * Get the width of all bricks.
+     *
+     * @returns
+     *   Widths, indexed by brick.
+     */
+    std::span<const float> width() const;
+
+    /**
+     * Get the height of all bricks.
+     *
+     * @returns
+     *   Heights, indexed by brick.
+     */
+    std::span<const float> height() const;
+
+    /**
+     * Get the colour of all bricks.
+     *
+     * @returns
+     *   Colours, indexed by brick.
+     */
+    std::span<const Colour> colour() const;
+
+    /**
+     * Get the alive mask of all bricks, a non-zero value means the brick is alive.
+     *
+     * @returns
+     *   Alive mask, indexed by brick.
+     */
+    std::span<const std::uint8_t> alive_mask() const;
+
+  private:
+    /**
+     * Move a brick to a new index, overwriting the brick at that index.
+     *
+     * @param from
+     *   Index of brick to move.
+     *
+     * @param to
+     *   Index to move brick to.
+     */
+    void move(std::size_t from, std::size_t to);
+
+    /**
+     * Remove the last brick.
+     */
+    void pop_back();
+
+    /** X coordinate of upper left corner of each brick. */
+    std::vector<float> x_;
+
+    /** Y coordinate of upper left corner of each brick. */
+    std::vector<float> y_;
+
+    /** Width of each brick. */
+    std::vector<float> width_;
+
+    /** Height of each brick. */
+    std::vector<float> height_;
+
+    /** Colour of each brick. */
+    std::vector<Colour> colour_;
+
+    /** Alive flag for each brick (std::vector<bool> is avoided so it can be streamed as bytes). */
+    std::vector<std::uint8_t> alive_;
+
+    /** Number of bricks still alive. */
+    std::size_t alive_count_ = 0u;
+
+    /** Indices of bricks destroyed since the last compaction. */
+    std::vector<std::size_t> destroyed_;
+};
+
+}
@@ -0,0 +1,140 @@
+////////////////////////////////////////////////////////////////////////////////
+//         Distributed under the Boost Software License, Version 1.0.         //
+//            (See accompanying file LICENSE or copy at                       //
+//                 https://www.boost.org/LICENSE_1_0.txt)                     //
+////////////////////////////////////////////////////////////////////////////////
+
+#include "brick_grid.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+
+#include "rectangle.h"
+
+namespace
+{
+
+/**
+ * Helper function to convert a coordinate into a cell index, clamped to the grid.
+ *
+ * @param value
+ *   Coordinate to convert.
+ *
+ * @param cell_size
+ *   Size of a cell along the coordinate axis.
+ *
+ * @param count
+ *   Number of cells along the coordinate axis.
+ *
+ * @returns
+ *   Index of cell containing the coordinate.
+ */
+std::size_t to_cell(float value, float cell_size, std::size_t count)
+{
+    const auto cell = std::floor(value / cell_size);
+
+    if (!(cell > 0.0f))
+    {
+        return 0u;
+    }
+
+    return std::min(static_cast<std::size_t>(cell), count - 1u);
+}
+
+}
+
+namespace cpp
+{
+
+BrickGrid::BrickGrid(float cell_width, float cell_height, std::size_t columns, std::size_t rows)
+    : cell_width_(cell_width)
+    , cell_height_(cell_height)
+    , columns_(columns)
+    , rows_(rows)
+    , cells_(columns * rows)
+{
+    assert(columns_ > 0u);
+    assert(rows_ > 0u);
+}
+
+void BrickGrid::insert(std::size_t index, const Rectangle &rectangle)
+{
+    const auto range = cell_range(rectangle);
+
+    for (auto row = range.first_row; row <= range.last_row; ++row)
+    {
+        for (auto column = range.first_column; column <= range.last_column; ++column)
+        {
+            auto &cell = cells_[(row * columns_) + column];
+
+            cell.x.push_back(rectangle.position.x);
+            cell.y.push_back(rectangle.position.y);
+            cell.width.push_back(rectangle.width);
+            cell.height.push_back(rectangle.height);
+            cell.index.push_back(static_cast<std::uint32_t>(index));
+        }
+    }
+}
+
+void BrickGrid::remove(std::size_t index, const Rectangle &rectangle)
+{
+    const auto range = cell_range(rectangle);
+
+    for (auto row = range.first_row; row <= range.last_row; ++row)
+    {
+        for (auto column = range.first_column; column <= range.last_column; ++column)
+        {
+            auto &cell = cells_[(row * columns_) + column];
+
+            // order within a cell doesn't matter, so swap the removed brick with the last one and pop
+            if (const auto found = std::ranges::find(cell.index, static_cast<std::uint32_t>(index));
+                found != cell.index.end())
+            {
+                const auto position = static_cast<std::size_t>(found - cell.index.begin());
+
+                for (auto *field : {&cell.x, &cell.y, &cell.width, &cell.height})
+                {
+                    (*field)[position] = field->back();
+                    field->pop_back();
+                }
+
+                cell.index[position] = cell.index.back();
+                cell.index.pop_back();
+            }
+        }
+    }
+}
+
+void BrickGrid::reindex(std::size_t old_index, std::size_t new_index, const Rectangle &rectangle)
+{
+    const auto range = cell_range(rectangle);
+
+    for (auto row = range.first_row; row <= range.last_row; ++row)
+    {
+        for (auto column = range.first_column; column <= range.last_column; ++column)
+        {
+            auto &cell = cells_[(row * columns_) + column];
+
+            if (const auto found = std::ranges::find(cell.index, static_cast<std::uint32_t>(old_index));
+                found != cell.index.end())
+            {
+                *found = static_cast<std::uint32_t>(new_index);
+            }
+        }
+    }
+}
+
+BrickGrid::CellRange BrickGrid::cell_range(const Rectangle &rectangle) const
+{
+    return {
+        .first_column = to_cell(rectangle.position.x, cell_width_, columns_),
+        .last_column = to_cell(rectangle.position.x + rectangle.width, cell_width_, columns_),
+        .first_row = to_cell(rectangle.position.y, cell_height_, rows_),
+        .last_row = to_cell(rectangle.position.y + rectangle.height, cell_height_, rows_),
+    };
+}
+
+}
@@ -0,0 +1,191 @@
+////////////////////////////////////////////////////////////////////////////////
+//         Distributed under the Boost Software License, Version 1.0.         //
+//            (See accompanying file LICENSE or copy at                       //
+//                 https://www.boost.org/LICENSE_1_0.txt)                     //
+////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include "rectangle.h"
+
+namespace cpp
+{
+
+/**
+ * BrickGrid is a uniform grid spatial index which maps cells to brick indices. A brick is stored in every cell its
+ * rectangle overlaps, so a query only has to inspect the handful of cells a rectangle touches rather than every brick.
+ *
+ * Each cell keeps a packed copy of its bricks' rectangles (as a structure of arrays) alongside their indices, so a query
+ * can run the batch intersection kernel straight over a cell without gathering coordinates from elsewhere.
+ *
+ * The grid covers the area from the origin to (columns * cell_width, rows * cell_height). Anything outside of that is
+ * clamped into the edge cells, so queries remain correct but less selective.
+ */
+class BrickGrid
+{
+  public:
+    /**
+     * Construct a new empty BrickGrid.
+     *
+     * @param cell_width
+     *   Width of a single cell.
+     *
+     * @param cell_height
+     *   Height of a single cell.
+     *
+     * @param columns
+     *   Number of cells along the x axis.
+     *
+     * @param rows
+     *   Number of cells along the y axis.
+     */
+    BrickGrid(float cell_width, float cell_height, std::size_t columns, std::size_t rows);
+
+    /**
+     * Insert a brick into the grid.
+     *
+     * @param index
+     *   Index of brick.
+     *
+     * @param rectangle
+     *   Area of brick.
+     */
+    void insert(std::size_t index, const Rectangle &rectangle);
+
+    /**
+     * Remove a brick from the grid. The supplied rectangle must be the same as the one it was inserted with.
+     *
+     * @param index
+     *   Index of brick.
+     *
+     * @param rectangle
+     *   Area of brick.
+     */
+    void remove(std::size_t index, const Rectangle &rectangle);
+
+    /**
+     * Change the index a brick is stored under. The supplied rectangle must be the same as the one it was inserted
+     * with.
+     *
+     * @param old_index
+     *   Current index of brick.
+     *
+     * @param new_index
+     *   New index of brick.
+     *
+     * @param rectangle
+     *   Area of brick.
+     */
+    void reindex(std::size_t old_index, std::size_t new_index, const Rectangle &rectangle);
+
+    /**
+     * Visit the index of every brick which intersects a rectangle. A brick which spans multiple cells may be visited
+     * more than once.
+     *
+     * @param rectangle
+     *   Area to query.
+     *
+     * @param visitor
+     *   Callable invoked with each intersecting brick index.
+     */
+    template <class Visitor>
+    void query(const Rectangle &rectangle, Visitor &&visitor) const
+    {
+        const auto range = cell_range(rectangle);
+
+        for (auto row = range.first_row; row <= range.last_row; ++row)
+        {
+            for (auto column = range.first_column; column <= range.last_column; ++column)
+            {
+                const auto &cell = cells_[(row * columns_) + column];
+
+                // run the batch kernel over the cell in fixed size chunks, so the hit mask can live on the stack
+                for (auto offset = std::size_t{0u}; offset < cell.index.size(); offset += max_chunk)
+                {
+                    const auto count = std::min(max_chunk, cell.index.size() - offset);
+                    std::array<std::uint64_t, max_chunk / 64u> hits{};
+
+                    intersects(
+                        rectangle,
+                        std::span{cell.x}.subspan(offset, count),
+                        std::span{cell.y}.subspan(offset, count),
+                        std::span{cell.width}.subspan(offset, count),
+                        std::span{cell.height}.subspan(offset, count),
+                        hits);
+
+                    for (auto word = std::size_t{0u}; word < hits.size(); ++word)
+                    {
+                        for (auto bits = hits[word]; bits != 0u; bits &= bits - 1u)
+                        {
+                            const auto hit = (word * 64u) + static_cast<std::size_t>(std::countr_zero(bits));
+                            visitor(static_cast<std::size_t>(cell.index[offset + hit]));
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+  private:
+    /** Maximum number of bricks passed to the batch kernel at once. */
+    static constexpr auto max_chunk = std::size_t{256u};
+
+    /**
+     * Packed bricks stored in a single cell.
+     */
+    struct Cell
+    {
+        std::vector<float> x;
+        std::vector<float> y;
+        std::vector<float> width;
+        std::vector<float> height;
+        std::vector<std::uint32_t> index;
+    };
+
+    /**
+     * Inclusive range of cells.
+     */
+    struct CellRange
+    {
+        std::size_t first_column;
+        std::size_t last_column;
+        std::size_t first_row;
+        std::size_t last_row;
+    };
+
+    /**
+     * Get the range of cells a rectangle overlaps, clamped to the grid.
+     *
+     * @param rectangle
+     *   Rectangle to get cells for.
+     *
+     * @returns
+     *   Range of overlapped cells.
+     */
+    CellRange cell_range(const Rectangle &rectangle) const;
+
+    /** Width of a single cell. */
+    float cell_width_;
+
+    /** Height of a single cell. */
+    float cell_height_;
+
+    /** Number of cells along the x axis. */
+    std::size_t columns_;
+
+    /** Number of cells along the y axis. */
+    std::size_t rows_;
+
+    /** Bricks stored in each cell, in row major order. */
+    std::vector<Cell> cells_;
+};
+
+}
@@ -0,0 +1,46 @@
+////////////////////////////////////////////////////////////////////////////////
+//         Distributed under the Boost Software License, Version 1.0.         //
+//            (See accompanying file LICENSE or copy at                       //
+//                 https://www.boost.org/LICENSE_1_0.txt)                     //
+////////////////////////////////////////////////////////////////////////////////
+
+#include "frame_pacer.h"
+
+#include <chrono>
+#include <thread>
+
+namespace cpp
+{
+
+FramePacer::FramePacer(std::chrono::nanoseconds frame_time, std::chrono::nanoseconds spin_time)
+    : frame_time_(std::chrono::duration_cast<std::chrono::steady_clock::duration>(frame_time))
+    , spin_time_(std::chrono::duration_cast<std::chrono::steady_clock::duration>(spin_time))
+    , deadline_(std::chrono::steady_clock::now() + frame_time_)
+{
+}
+
+void FramePacer::wait()
+{
+    auto now = std::chrono::steady_clock::now();
+
+    // sleep for most of the remaining time
+    if (now < deadline_ - spin_time_)
+    {
+        std::this_thread::sleep_for(deadline_ - spin_time_ - now);
+    }
+
+    // then spin until the deadline
+    do
+    {
+        now = std::chrono::steady_clock::now();
+    } while (now < deadline_);
+
+    deadline_ += frame_time_;
+
+    if (deadline_ < now)
+    {
+        deadline_ = now + frame_time_;
+    }
+}
+
+}
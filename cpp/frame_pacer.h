@@ -0,0 +1,49 @@
+////////////////////////////////////////////////////////////////////////////////
+//         Distributed under the Boost Software License, Version 1.0.         //
+//            (See accompanying file LICENSE or copy at                       //
+//                 https://www.boost.org/LICENSE_1_0.txt)                     //
+////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <chrono>
+
+namespace cpp
+{
+
+/**
+ * FramePacer blocks the calling thread so that frames start at a fixed interval. It sleeps for the bulk of the wait
+ * (releasing the core) then spins for the final stretch, as OS sleeps are too coarse to hit a deadline precisely.
+ */
+class FramePacer
+{
+  public:
+    /**
+     * Construct a new FramePacer, the first deadline is one frame from now.
+     *
+     * @param frame_time
+     *   Target time between the start of each frame.
+     *
+     * @param spin_time
+     *   How long before a deadline to stop sleeping and start spinning.
+     */
+    FramePacer(std::chrono::nanoseconds frame_time, std::chrono::nanoseconds spin_time);
+
+    /**
+     * Block until the current frame deadline, then advance the deadline by one frame. If the deadline was missed by
+     * more than a whole frame it is reset relative to now, rather than running a burst of frames to catch up.
+     */
+    void wait();
+
+  private:
+    /** Target time between the start of each frame. */
+    std::chrono::steady_clock::duration frame_time_;
+
+    /** How long before a deadline to stop sleeping and start spinning. */
+    std::chrono::steady_clock::duration spin_time_;
+
+    /** Time the current frame should end. */
+    std::chrono::steady_clock::time_point deadline_;
+};
+
+}
@@ -0,0 +1,115 @@
+////////////////////////////////////////////////////////////////////////////////
+//         Distributed under the Boost Software License, Version 1.0.         //
+//            (See accompanying file LICENSE or copy at                       //
+//                 https://www.boost.org/LICENSE_1_0.txt)                     //
+////////////////////////////////////////////////////////////////////////////////
+
+#include "input_script.h"
+
+#include <charconv>
+#include <cstddef>
+#include <cstdint>
+#include <istream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+
+#include "input_state.h"
+
+namespace
+{
+
+/**
+ * Helper function to build an error for a line of a script.
+ *
+ * @param line_number
+ *   Line the error is on (1 based).
+ *
+ * @param message
+ *   Description of error.
+ *
+ * @returns
+ *   Exception to throw.
+ */
+std::runtime_error parse_error(std::size_t line_number, const std::string &message)
+{
+    return std::runtime_error{"input script line " + std::to_string(line_number) + ": " + message};
+}
+
+}
+
+namespace cpp
+{
+
+InputScript::InputScript(std::istream &is)
+    : changes_()
+{
+    std::string line;
+    auto line_number = std::size_t{0u};
+
+    while (std::getline(is, line))
+    {
+        ++line_number;
+
+        // strip comments
+        if (const auto comment = line.find('#'); comment != std::string::npos)
+        {
+            line.erase(comment);
+        }
+
+        std::istringstream tokens{line};
+        std::string token;
+
+        if (!(tokens >> token))
+        {
+            continue;
+        }
+
+        Change change{};
+
+        // from_chars (unlike stoull) rejects signs and whitespace, and we check it consumed the whole token
+        const auto token_end = token.data() + token.size();
+        if (const auto [end, error] = std::from_chars(token.data(), token_end, change.step);
+            (error != std::errc{}) || (end != token_end))
+        {
+            throw parse_error(line_number, "invalid step '" + token + "'");
+        }
+
+        if (!changes_.empty() && (change.step < changes_.back().step))
+        {
+            throw parse_error(line_number, "step goes backwards");
+        }
+
+        while (tokens >> token)
+        {
+            if (token == "left")
+            {
+                change.input.left = true;
+            }
+            else if (token == "right")
+            {
+                change.input.right = true;
+            }
+            else
+            {
+                throw parse_error(line_number, "unknown key '" + token + "'");
+            }
+        }
+
+        changes_.push_back(change);
+    }
+}
+
+InputState InputScript::input(std::uint64_t step, std::size_t &cursor) const
+{
+    // move on past every change which has started
+    while ((cursor < changes_.size()) && (changes_[cursor].step <= step))
+    {
+        ++cursor;
+    }
+
+    return (cursor == 0u) ? InputState{} : changes_[cursor - 1u].input;
+}
+
+}
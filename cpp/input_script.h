@@ -0,0 +1,77 @@
+////////////////////////////////////////////////////////////////////////////////
+//         Distributed under the Boost Software License, Version 1.0.         //
+//            (See accompanying file LICENSE or copy at                       //
+//                 https://www.boost.org/LICENSE_1_0.txt)                     //
+////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <iosfwd>
+#include <vector>
+
+#include "input_state.h"
+
+namespace cpp
+{
+
+/**
+ * InputScript is a recorded sequence of player inputs, used to drive a Simulation without a player.
+ *
+ * Scripts are parsed from text with one change of input per line, in the form:
+ *
+ *   <step> [left] [right]
+ *
+ * The listed keys are held from that step until the step of the next line, an empty key list releases everything.
+ * Steps must not decrease. Blank lines and anything after a '#' are ignored. Before the first line no keys are held.
+ */
+class InputScript
+{
+  public:
+    /**
+     * Construct an empty InputScript, which never holds any keys.
+     */
+    InputScript() = default;
+
+    /**
+     * Construct an InputScript by parsing text. Throws std::runtime_error if the text is malformed.
+     *
+     * @param is
+     *   Stream to read script from.
+     */
+    explicit InputScript(std::istream &is);
+
+    /**
+     * Get the input for a step. To avoid searching the whole script each time a cursor is kept by the caller, so steps
+     * must be requested in increasing order with the same cursor.
+     *
+     * @param step
+     *   Step to get input for.
+     *
+     * @param cursor
+     *   Position in script, should start at 0 and is updated by each call.
+     *
+     * @returns
+     *   Input held at step.
+     */
+    InputState input(std::uint64_t step, std::size_t &cursor) const;
+
+  private:
+    /**
+     * Struct encapsulating a single change of input.
+     */
+    struct Change
+    {
+        /** Step the input applies from. */
+        std::uint64_t step;
+
+        /** Input held from step. */
+        InputState input;
+    };
+
+    /** All changes, in step order. */
+    std::vector<Change> changes_;
+};
+
+}
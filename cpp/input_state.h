@@ -0,0 +1,24 @@
+////////////////////////////////////////////////////////////////////////////////
+//         Distributed under the Boost Software License, Version 1.0.         //
+//            (See accompanying file LICENSE or copy at                       //
+//                 https://www.boost.org/LICENSE_1_0.txt)                     //
+////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+namespace cpp
+{
+
+/**
+ * Struct encapsulating the state of all player inputs for a single simulation step.
+ */
+struct InputState
+{
+    /** True if the left key is held. */
+    bool left = false;
+
+    /** True if the right key is held. */
+    bool right = false;
+};
+
+}
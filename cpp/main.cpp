@@ -4,223 +4,201 @@
 //                 https://www.boost.org/LICENSE_1_0.txt)                     //
 ////////////////////////////////////////////////////////////////////////////////
 
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <fstream>
+#include <future>
 #include <iostream>
-#include <ranges>
+#include <span>
+#include <string_view>
 
-#include "colour.h"
 #include "entity.h"
+#include "frame_pacer.h"
+#include "input_state.h"
 #include "key_event.h"
+#include "profiler.h"
 #include "rectangle.h"
+#include "simulation.h"
 #include "vector2.h"
 #include "window.h"
 
 namespace
 {
 
-/**
- * Helper function to create a row of 10 bricks.
- *
- * @param entities
- *   Collection to add new entities to.
- *
- * @param y
- *   Y coordinate of row.
- *
- * @param colour
- *   Colour of bricks.
- */
-void create_brick_row(std::vector<cpp::Entity> &entities, float y, const cpp::Colour &colour)
-{
-    auto x = 20.0f;
+using namespace std::chrono_literals;
 
-    for (auto i = 0u; i < 10u; ++i)
-    {
-        entities.push_back({{{x, y}, 58.0f, 20.0f}, colour});
-        x += 78.0f;
-    }
-}
+/** Fixed time simulated by each simulation step (240Hz). */
+constexpr std::chrono::nanoseconds tick_time{1'000'000'000 / 240};
+
+/** Target time between rendered frames (60Hz). */
+constexpr std::chrono::nanoseconds frame_time{1'000'000'000 / 60};
+
+/** How long before a frame deadline the pacer stops sleeping and starts spinning. */
+constexpr std::chrono::nanoseconds spin_time = 2ms;
+
+/** Cap on how much time a single frame can add to the simulation, stops a long stall causing a huge burst of steps. */
+constexpr std::chrono::nanoseconds max_frame_delta = 250ms;
+
+/** Minimum time between automatic trace dumps, so a run of slow frames doesn't spend all its time writing traces. */
+constexpr std::chrono::nanoseconds trace_cooldown = 5s;
+
+/** File profiler traces are written to. */
+constexpr auto trace_path = "cpp_game_trace.json";
 
 /**
- * Helper function to check for and resolve collisions between the ball and other entities.
+ * Helper function to interpolate between two states of an entity.
  *
- * @param ball
- *   Ball to check for collisions.
+ * @param previous
+ *   Entity state at the previous simulation step.
  *
- * @param ball_velocity
- *   Velocity of ball, might get mutated during collision response.
+ * @param current
+ *   Entity state at the current simulation step.
  *
- * @param paddle
- *   Paddle to check for collisions with.
+ * @param alpha
+ *   Interpolation factor, 0.0 gives previous and 1.0 gives current.
  *
- * @param entities
- *   Collection of all entities, brick entities will be removed if a collision is detected.
+ * @returns
+ *   Entity with interpolated position.
  */
-void check_collisions(
-    const cpp::Entity &ball,
-    cpp::Vector2 &ball_velocity,
-    const cpp::Entity &paddle,
-    std::vector<cpp::Entity> &entities)
+cpp::Entity interpolate(const cpp::Entity &previous, const cpp::Entity &current, float alpha)
 {
-    // check and handle ball and paddle collision
-    if (paddle.intersects(ball))
-    {
-        const auto ball_pos = ball.rectangle().position;
-        const auto paddle_pos = paddle.rectangle().position;
+    const auto previous_rect = previous.rectangle();
+    const auto current_rect = current.rectangle();
 
-        if (ball_pos.x < paddle_pos.x + 100.0f)
-        {
-            ball_velocity.x = -0.7f;
-            ball_velocity.y = -0.7f;
-        }
-        else if (ball_pos.x < paddle_pos.x + 200.0f)
-        {
-            ball_velocity.x = 0.0f;
-            ball_velocity.y = -1.0f;
-        }
-        else
-        {
-            ball_velocity.x = 0.7f;
-            ball_velocity.y = -0.7f;
-        }
-    }
-    else
-    {
-        // only check brick intersections if we didn't intersect the paddle, unlikely these will both happen in the same
-        // frame due to the layout of the game
-
-        // iterate over all entities, skipping the first two as these are the paddle and ball
-        auto bricks_view = entities | std::views::drop(2u);
-        auto hit_brick =
-            std::ranges::find_if(bricks_view, [&ball](const auto &brick) { return ball.intersects(brick); });
+    const cpp::Vector2 position{
+        previous_rect.position.x + ((current_rect.position.x - previous_rect.position.x) * alpha),
+        previous_rect.position.y + ((current_rect.position.y - previous_rect.position.y) * alpha)};
 
-        if (hit_brick != std::ranges::end(bricks_view))
-        {
-            // we hit a brick so update ball velocity and remove brick entity
-            ball_velocity.y *= -1.0f;
-            entities.erase(hit_brick);
-        }
-    }
+    return {{position, current_rect.width, current_rect.height}, current.colour()};
 }
 
 /**
- * Helper function to update the ball. Will check if the ball leaves the window and adjust the velocity so it "bounces"
- * off walls.
- *
- * @param ball
- *   Ball entity to update.
- *
- * @param velocity
- *   Ball velocity, will be mutated if ball goes off screen.
+ * Helper function to write the profiler flight recorder to disk.
  */
-void update_ball(cpp::Entity &ball, cpp::Vector2 &velocity)
+void dump_trace()
 {
-    ball.translate(velocity);
+    std::ofstream trace_file{trace_path};
+    cpp::Profiler::write_chrome_trace(trace_file);
 
-    const auto ball_pos = ball.rectangle().position;
-
-    if ((ball_pos.y > 800.0f) || (ball_pos.y < 0.0f))
-    {
-        velocity.y *= -1.0f;
-    }
-
-    if ((ball_pos.x > 800.0f) || (ball_pos.x < 0.0f))
-    {
-        velocity.x *= -1.0f;
-    }
+    std::cout << "wrote trace to " << trace_path << "\n";
 }
 
 /**
- * Helper function to update the paddle.
- *
- * @param paddle
- *   Paddle entity to update.
+ * Helper function to start writing the profiler flight recorder on a background thread, so file IO doesn't stall the
+ * game loop. Does nothing if the previous dump is still being written.
  *
- * @param velocity
- *   Paddle velocity.
+ * @param dump
+ *   Handle to the most recent dump, replaced if a new dump is started.
  */
-void update_paddle(cpp::Entity &paddle, const cpp::Vector2 &velocity)
+void start_trace_dump(std::future<void> &dump)
 {
-    paddle.translate(velocity);
+    if (dump.valid() && (dump.wait_for(0s) != std::future_status::ready))
+    {
+        return;
+    }
+
+    dump = std::async(std::launch::async, dump_trace);
 }
 
 }
 
-int main()
+int main(int argc, char **argv)
 {
     std::cout << "hello world\n";
 
-    const cpp::Window window{};
+    // optionally rasterise on the CPU rather than with the SDL renderer
+    const auto backend = ((argc > 1) && (std::string_view{argv[1]} == "--software")) ? cpp::RenderBackend::SOFTWARE
+                                                                                       : cpp::RenderBackend::HARDWARE;
+
+    const cpp::Window window{backend};
     auto running = true;
 
-    std::vector<cpp::Entity> entities{
-        {{{300.0f, 780.0f}, 300.0f, 20.0f}, 0xFFFFFF}, {{{420.0f, 400.0f}, 10.0f, 10.0f}, 0xFFFFFF}};
+    cpp::Simulation simulation{};
+    cpp::InputState input{};
+    std::array<cpp::KeyEvent, 64u> events{};
 
-    create_brick_row(entities, 50.0f, 0xff0000);
-    create_brick_row(entities, 80.0f, 0xff0000);
-    create_brick_row(entities, 110.0f, 0xffa500);
-    create_brick_row(entities, 140.0f, 0xffa500);
-    create_brick_row(entities, 170.0f, 0x00ff00);
-    create_brick_row(entities, 200.0f, 0x00ff00);
+    // the simulation is stepped at a fixed rate, decoupled from the render rate, with rendered positions interpolated
+    // between the last two steps
+    auto previous_paddle = simulation.paddle();
+    auto previous_ball = simulation.ball();
+    auto previous_time = std::chrono::steady_clock::now();
+    std::chrono::nanoseconds accumulator{0};
+    cpp::FramePacer pacer{frame_time, spin_time};
+    std::future<void> trace_dump{};
 
-    cpp::Vector2 ball_velocity{0.0f, 1.0f};
-    cpp::Vector2 paddle_velocity{0.0f, 0.0f};
-    const float paddle_speed = 1.0f;
-    auto left_press = false;
-    auto right_press = false;
+    // start the cooldown at the loop start, so the slow first frames (texture and window setup) don't dump every launch
+    auto last_trace_dump = previous_time;
 
     while (running)
     {
-        for (;;)
+        const auto frame_start = cpp::Profiler::now();
+        const auto now = std::chrono::steady_clock::now();
+        const auto frame_delta = std::chrono::duration_cast<std::chrono::nanoseconds>(now - previous_time);
+        accumulator += std::min(frame_delta, max_frame_delta);
+        previous_time = now;
+
+        const auto polled = [&window, &events] {
+            const cpp::ScopedTimer timer{"poll_events"};
+            return window.poll_events(events);
+        }();
+
+        for (const auto &event : std::span{events}.first(polled.count))
         {
-            if (const auto event = window.get_event(); event)
+            using enum cpp::Key;
+            using enum cpp::KeyState;
+
+            if ((event.key_state == DOWN) && (event.key == ESCAPE))
             {
-                using enum cpp::Key;
-                using enum cpp::KeyState;
-
-                if ((event->key_state == DOWN) && (event->key == ESCAPE))
-                {
-                    running = false;
-                }
-                else if (event->key == LEFT)
-                {
-                    left_press = (event->key_state == DOWN) ? true : false;
-                }
-                else if (event->key == RIGHT)
-                {
-                    right_press = (event->key_state == DOWN) ? true : false;
-                }
+                running = false;
             }
-            else
+            else if (event.key == LEFT)
             {
-                break;
+                input.left = (event.key_state == DOWN) ? true : false;
+            }
+            else if (event.key == RIGHT)
+            {
+                input.right = (event.key_state == DOWN) ? true : false;
+            }
+            else if ((event.key_state == DOWN) && (event.key == F12))
+            {
+                start_trace_dump(trace_dump);
             }
         }
 
-        if ((left_press && right_press) || (!left_press && !right_press))
+        while (accumulator >= tick_time)
         {
-            paddle_velocity.x = 0.0f;
-        }
-        else if (left_press)
-        {
-            paddle_velocity.x = -paddle_speed;
+            const cpp::ScopedTimer timer{"step"};
+
+            previous_paddle = simulation.paddle();
+            previous_ball = simulation.ball();
+
+            simulation.step(input);
+            accumulator -= tick_time;
         }
-        else if (right_press)
+
+        const auto alpha = std::chrono::duration<float>(accumulator) / std::chrono::duration<float>(tick_time);
+
+        const std::array entities{
+            interpolate(previous_paddle, simulation.paddle(), alpha),
+            interpolate(previous_ball, simulation.ball(), alpha)};
+
         {
-            paddle_velocity.x = paddle_speed;
+            const cpp::ScopedTimer timer{"render"};
+            window.render(entities, simulation.bricks());
         }
 
-        // scope the references to the paddle and ball, if check_collisions results in an entity being removed then
-        // that will invalidate our references, so prevent them from being accidentally used later
-        {
-            auto &paddle = entities[0];
-            auto &ball = entities[1];
+        const auto frame_duration = cpp::Profiler::now() - frame_start;
+        cpp::Profiler::record("frame", frame_start, frame_duration);
 
-            update_paddle(paddle, paddle_velocity);
-            update_ball(ball, ball_velocity);
-            check_collisions(ball, ball_velocity, paddle, entities);
+        // if this frame took longer than our budget then dump the flight recorder, so we can see what happened
+        if ((std::chrono::nanoseconds{frame_duration} > frame_time) && (now - last_trace_dump > trace_cooldown))
+        {
+            start_trace_dump(trace_dump);
+            last_trace_dump = now;
         }
 
-        window.render(entities);
+        pacer.wait();
     }
 
     std::cout << "goodbye\n";
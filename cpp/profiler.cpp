@@ -0,0 +1,192 @@
+////////////////////////////////////////////////////////////////////////////////
+//         Distributed under the Boost Software License, Version 1.0.         //
+//            (See accompanying file LICENSE or copy at                       //
+//                 https://www.boost.org/LICENSE_1_0.txt)                     //
+////////////////////////////////////////////////////////////////////////////////
+
+#include "profiler.h"
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <iomanip>
+#include <ios>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace
+{
+
+/**
+ * Struct encapsulating a single completed scope. Slots are read by dumping threads whilst the owning thread may be
+ * overwriting them, so every field is atomic and a slot is published seqlock style: sequence is odd whilst the slot is
+ * being written and 2 * (n + 1) once it holds event n.
+ */
+struct ProfileEvent
+{
+    std::atomic<std::uint64_t> sequence;
+    std::atomic<const char *> name;
+    std::atomic<std::int64_t> start;
+    std::atomic<std::int64_t> duration;
+};
+
+/**
+ * Ring buffer of events recorded by a single thread.
+ */
+struct ThreadBuffer
+{
+    /** Id of owning thread, used in the trace output. */
+    std::uint32_t thread_id;
+
+    /** Total number of events ever recorded, the next event is written to (head % capacity). */
+    std::atomic<std::uint64_t> head;
+
+    /** Recorded events. */
+    std::array<ProfileEvent, cpp::Profiler::capacity> events;
+};
+
+/** Whether scopes are recorded. */
+std::atomic<bool> recording_enabled{true};
+
+/** Guards thread_buffers. */
+std::mutex registry_mutex;
+
+/** Buffers for every thread that has recorded an event, these outlive their thread so they can still be dumped. */
+std::vector<std::shared_ptr<ThreadBuffer>> thread_buffers;
+
+/**
+ * Helper function to get the ring buffer for the calling thread, creating and registering it on first use.
+ *
+ * @returns
+ *   Buffer for calling thread.
+ */
+ThreadBuffer &local_buffer()
+{
+    thread_local const auto buffer = [] {
+        auto new_buffer = std::make_shared<ThreadBuffer>();
+        new_buffer->head.store(0u, std::memory_order_relaxed);
+
+        const std::scoped_lock lock{registry_mutex};
+        new_buffer->thread_id = static_cast<std::uint32_t>(thread_buffers.size());
+        thread_buffers.push_back(new_buffer);
+
+        return new_buffer;
+    }();
+
+    return *buffer;
+}
+
+}
+
+namespace cpp
+{
+
+std::int64_t Profiler::now()
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch())
+        .count();
+}
+
+bool Profiler::enabled()
+{
+    return recording_enabled.load(std::memory_order_relaxed);
+}
+
+void Profiler::set_enabled(bool enabled)
+{
+    recording_enabled.store(enabled, std::memory_order_relaxed);
+}
+
+void Profiler::record(const char *name, std::int64_t start, std::int64_t duration)
+{
+    auto &buffer = local_buffer();
+
+    // only this thread writes head, so a relaxed load is fine, the release stores publish the event to dumpers
+    const auto head = buffer.head.load(std::memory_order_relaxed);
+    auto &event = buffer.events[head % capacity];
+
+    // mark the slot as being written before touching any field, so a dumper reading it concurrently will discard it
+    event.sequence.store((head * 2u) + 1u, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    event.name.store(name, std::memory_order_relaxed);
+    event.start.store(start, std::memory_order_relaxed);
+    event.duration.store(duration, std::memory_order_relaxed);
+
+    event.sequence.store((head + 1u) * 2u, std::memory_order_release);
+    buffer.head.store(head + 1u, std::memory_order_release);
+}
+
+void Profiler::write_chrome_trace(std::ostream &os)
+{
+    const std::scoped_lock lock{registry_mutex};
+
+    // timestamps are large so make sure we don't end up with them in scientific notation
+    const auto flags = os.flags();
+    const auto precision = os.precision();
+    os << std::fixed << std::setprecision(3);
+
+    os << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+
+    auto first = true;
+
+    for (const auto &buffer : thread_buffers)
+    {
+        const auto head = buffer->head.load(std::memory_order_acquire);
+        const auto tail = (head > capacity) ? head - capacity : 0u;
+
+        for (auto i = tail; i < head; ++i)
+        {
+            const auto &event = buffer->events[i % capacity];
+
+            // skip the slot if it no longer holds event i, or if it was overwritten whilst we were copying it out
+            const auto sequence = event.sequence.load(std::memory_order_acquire);
+            if (sequence != (i + 1u) * 2u)
+            {
+                continue;
+            }
+
+            const auto name = event.name.load(std::memory_order_relaxed);
+            const auto start = event.start.load(std::memory_order_relaxed);
+            const auto duration = event.duration.load(std::memory_order_relaxed);
+
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (event.sequence.load(std::memory_order_relaxed) != sequence)
+            {
+                continue;
+            }
+
+            // trace_event timestamps are in microseconds
+            os << (first ? "" : ",") << "{\"name\":\"" << name << "\",\"ph\":\"X\",\"pid\":1,\"tid\":"
+               << buffer->thread_id << ",\"ts\":" << (static_cast<double>(start) / 1000.0)
+               << ",\"dur\":" << (static_cast<double>(duration) / 1000.0) << "}";
+
+            first = false;
+        }
+    }
+
+    os << "]}\n";
+
+    os.flags(flags);
+    os.precision(precision);
+}
+
+ScopedTimer::ScopedTimer(const char *name)
+    : name_(name)
+    , start_(Profiler::enabled() ? Profiler::now() : -1)
+{
+}
+
+ScopedTimer::~ScopedTimer()
+{
+    if (start_ >= 0)
+    {
+        Profiler::record(name_, start_, Profiler::now() - start_);
+    }
+}
+
+}
@@ -0,0 +1,116 @@
+////////////////////////////////////////////////////////////////////////////////
+//         Distributed under the Boost Software License, Version 1.0.         //
+//            (See accompanying file LICENSE or copy at                       //
+//                 https://www.boost.org/LICENSE_1_0.txt)                     //
+////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <iosfwd>
+
+namespace cpp
+{
+
+/**
+ * Profiler is an always on flight recorder of timed scopes. Each thread records into its own fixed size ring buffer, so
+ * recording never allocates or takes a lock (after the first event on a thread) and only the most recent events are
+ * kept.
+ *
+ * Scopes are recorded with ScopedTimer and can be dumped at any time in the Chrome trace_event JSON format, which can
+ * be loaded into chrome://tracing or Perfetto.
+ *
+ * Recording is enabled by default. Hosts which step the simulation far faster than a frame rate (where even a clock
+ * read per scope is significant) can disable it, in which case a ScopedTimer costs a single flag check.
+ */
+class Profiler
+{
+  public:
+    /** Number of events kept per thread. */
+    static constexpr std::size_t capacity = 16384u;
+
+    /**
+     * Get the current time, in the same clock as recorded events.
+     *
+     * @returns
+     *   Current time in nanoseconds.
+     */
+    static std::int64_t now();
+
+    /**
+     * Check if recording is enabled.
+     *
+     * @returns
+     *   True if scopes are being recorded, otherwise false.
+     */
+    static bool enabled();
+
+    /**
+     * Enable or disable recording, for all threads.
+     *
+     * @param enabled
+     *   True to record scopes, false to ignore them.
+     */
+    static void set_enabled(bool enabled);
+
+    /**
+     * Record a completed scope on the calling thread.
+     *
+     * @param name
+     *   Name of scope, must have static storage duration (e.g. a string literal) and not need JSON escaping.
+     *
+     * @param start
+     *   Start time of scope, as returned by now.
+     *
+     * @param duration
+     *   Duration of scope in nanoseconds.
+     */
+    static void record(const char *name, std::int64_t start, std::int64_t duration);
+
+    /**
+     * Write all recorded events, from all threads, as Chrome trace_event JSON.
+     *
+     * Threads may keep recording whilst this runs, the oldest events of a thread that is actively recording may be
+     * overwritten as they are written out, in which case they are skipped.
+     *
+     * @param os
+     *   Stream to write to.
+     */
+    static void write_chrome_trace(std::ostream &os);
+};
+
+/**
+ * ScopedTimer records the lifetime of a scope with the Profiler.
+ */
+class ScopedTimer
+{
+  public:
+    /**
+     * Construct a new ScopedTimer, starting the timer.
+     *
+     * @param name
+     *   Name of scope, must have static storage duration (e.g. a string literal) and not need JSON escaping.
+     */
+    explicit ScopedTimer(const char *name);
+
+    /**
+     * Stop the timer and record the scope.
+     */
+    ~ScopedTimer();
+
+    ScopedTimer(const ScopedTimer &) = delete;
+    ScopedTimer &operator=(const ScopedTimer &) = delete;
+
+    ScopedTimer(ScopedTimer &&) = delete;
+    ScopedTimer &operator=(ScopedTimer &&) = delete;
+
+  private:
+    /** Name of scope. */
+    const char *name_;
+
+    /** Start time of scope, negative if recording was disabled when the timer started. */
+    std::int64_t start_;
+};
+
+}
@@ -6,10 +6,109 @@
 
 #include "rectangle.h"
 
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
 #include <iostream>
+#include <span>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && (_M_IX86_FP >= 2))
+#define CPP_SIM_SSE2
+#include <emmintrin.h>
+#endif
 
 #include "vector2.h"
 
+namespace
+{
+
+#if defined(__AVX2__)
+
+/** Number of rectangles tested per kernel invocation. */
+constexpr auto batch_lanes = std::size_t{8u};
+
+/**
+ * Helper function to test a rectangle against a block of packed rectangles.
+ *
+ * @param rect
+ *   Rectangle to check for intersection.
+ *
+ * @param x
+ *   Address of first x coordinate in block.
+ *
+ * @param y
+ *   Address of first y coordinate in block.
+ *
+ * @param width
+ *   Address of first width in block.
+ *
+ * @param height
+ *   Address of first height in block.
+ *
+ * @returns
+ *   Bitmask of intersecting rectangles in the block.
+ */
+std::uint64_t intersects_block(
+    const cpp::Rectangle &rect,
+    const float *x,
+    const float *y,
+    const float *width,
+    const float *height)
+{
+    const auto rect_x = _mm256_set1_ps(rect.position.x);
+    const auto rect_y = _mm256_set1_ps(rect.position.y);
+    const auto rect_right = _mm256_set1_ps(rect.position.x + rect.width);
+    const auto rect_bottom = _mm256_set1_ps(rect.height + rect.position.y);
+
+    const auto block_x = _mm256_loadu_ps(x);
+    const auto block_y = _mm256_loadu_ps(y);
+    const auto block_right = _mm256_add_ps(block_x, _mm256_loadu_ps(width));
+    const auto block_bottom = _mm256_add_ps(block_y, _mm256_loadu_ps(height));
+
+    const auto overlap_x = _mm256_and_ps(
+        _mm256_cmp_ps(rect_x, block_right, _CMP_LT_OQ), _mm256_cmp_ps(rect_right, block_x, _CMP_GT_OQ));
+    const auto overlap_y = _mm256_and_ps(
+        _mm256_cmp_ps(rect_y, block_bottom, _CMP_LT_OQ), _mm256_cmp_ps(rect_bottom, block_y, _CMP_GT_OQ));
+
+    return static_cast<std::uint64_t>(_mm256_movemask_ps(_mm256_and_ps(overlap_x, overlap_y)));
+}
+
+#elif defined(CPP_SIM_SSE2)
+
+/** Number of rectangles tested per kernel invocation. */
+constexpr auto batch_lanes = std::size_t{4u};
+
+// see docs on AVX2 implementation
+std::uint64_t intersects_block(
+    const cpp::Rectangle &rect,
+    const float *x,
+    const float *y,
+    const float *width,
+    const float *height)
+{
+    const auto rect_x = _mm_set1_ps(rect.position.x);
+    const auto rect_y = _mm_set1_ps(rect.position.y);
+    const auto rect_right = _mm_set1_ps(rect.position.x + rect.width);
+    const auto rect_bottom = _mm_set1_ps(rect.height + rect.position.y);
+
+    const auto block_x = _mm_loadu_ps(x);
+    const auto block_y = _mm_loadu_ps(y);
+    const auto block_right = _mm_add_ps(block_x, _mm_loadu_ps(width));
+    const auto block_bottom = _mm_add_ps(block_y, _mm_loadu_ps(height));
+
+    const auto overlap_x = _mm_and_ps(_mm_cmplt_ps(rect_x, block_right), _mm_cmpgt_ps(rect_right, block_x));
+    const auto overlap_y = _mm_and_ps(_mm_cmplt_ps(rect_y, block_bottom), _mm_cmpgt_ps(rect_bottom, block_y));
+
+    return static_cast<std::uint64_t>(_mm_movemask_ps(_mm_and_ps(overlap_x, overlap_y)));
+}
+
+#endif
+
+}
+
 namespace cpp
 {
 
@@ -32,6 +131,43 @@ bool Rectangle::intersects(const Rectangle &rect) const
         (position.y < rect.position.y + rect.height) && (height + position.y > rect.position.y));
 }
 
+void intersects(
+    const Rectangle &rect,
+    std::span<const float> x,
+    std::span<const float> y,
+    std::span<const float> width,
+    std::span<const float> height,
+    std::span<std::uint64_t> hits)
+{
+    const auto count = x.size();
+
+    assert(y.size() == count);
+    assert(width.size() == count);
+    assert(height.size() == count);
+    assert(hits.size() >= (count + 63u) / 64u);
+
+    std::ranges::fill(hits, std::uint64_t{0u});
+
+    auto i = std::size_t{0u};
+
+#if defined(__AVX2__) || defined(CPP_SIM_SSE2)
+    // lanes divide 64 so a block never straddles two mask words
+    for (; i + batch_lanes <= count; i += batch_lanes)
+    {
+        hits[i / 64u] |= intersects_block(rect, &x[i], &y[i], &width[i], &height[i]) << (i % 64u);
+    }
+#endif
+
+    // scalar tail (or the whole batch if there is no vector kernel)
+    for (; i < count; ++i)
+    {
+        if (rect.intersects({{x[i], y[i]}, width[i], height[i]}))
+        {
+            hits[i / 64u] |= std::uint64_t{1u} << (i % 64u);
+        }
+    }
+}
+
 bool operator==(const Rectangle &r1, const Rectangle &r2)
 {
     return (r1.position == r2.position) && (r1.width == r2.width) && (r1.height == r2.height);
@@ -6,7 +6,9 @@
 
 #pragma once
 
+#include <cstdint>
 #include <iosfwd>
+#include <span>
 
 #include "vector2.h"
 
@@ -105,6 +107,39 @@ bool operator==(const Rectangle &r1, const Rectangle &r2);
  */
 bool operator!=(const Rectangle &r1, const Rectangle &r2);
 
+/**
+ * Check a rectangle against a batch of packed rectangles. The batch is supplied as a structure of arrays, all of which
+ * must be the same length. The result is written as a bitmask where bit (i % 64) of word (i / 64) is set if rectangle
+ * i intersects the supplied rectangle. The intersection test is identical to Rectangle::intersects.
+ *
+ * Depending on the target this uses an AVX2 (8 wide), SSE2 (4 wide) or scalar kernel, see CPP_SIM_AVX2.
+ *
+ * @param rect
+ *   Rectangle to check for intersection.
+ *
+ * @param x
+ *   X coordinates of batch rectangles.
+ *
+ * @param y
+ *   Y coordinates of batch rectangles.
+ *
+ * @param width
+ *   Widths of batch rectangles.
+ *
+ * @param height
+ *   Heights of batch rectangles.
+ *
+ * @param hits
+ *   Out parameter for hit bitmask, must have room for at least (x.size() + 63) / 64 words.
+ */
+void intersects(
+    const Rectangle &rect,
+    std::span<const float> x,
+    std::span<const float> y,
+    std::span<const float> width,
+    std::span<const float> height,
+    std::span<std::uint64_t> hits);
+
 // see docs on class definition
 std::ostream &operator<<(std::ostream &os, const Rectangle &rect);
 
@@ -0,0 +1,247 @@
+////////////////////////////////////////////////////////////////////////////////
+//         Distributed under the Boost Software License, Version 1.0.         //
+//            (See accompanying file LICENSE or copy at                       //
+//                 https://www.boost.org/LICENSE_1_0.txt)                     //
+////////////////////////////////////////////////////////////////////////////////
+
+#include "simulation.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <limits>
+
+#include "brick_field.h"
+#include "brick_grid.h"
+#include "colour.h"
+#include "entity.h"
+#include "input_state.h"
+#include "profiler.h"
+#include "rectangle.h"
+#include "vector2.h"
+
+namespace
+{
+
+/** Speed the paddle moves at when a direction is held. */
+constexpr auto paddle_speed = 1.0f;
+
+/** Horizontal distance between the start of adjacent bricks in a row, also used as the brick grid cell width. */
+constexpr auto brick_pitch_x = 78.0f;
+
+/** Vertical distance between adjacent brick rows, also used as the brick grid cell height. */
+constexpr auto brick_pitch_y = 30.0f;
+
+/** Size of the playing area (along both axes). */
+constexpr auto world_size = 800.0f;
+
+/**
+ * Helper function to create a row of 10 bricks.
+ *
+ * @param bricks
+ *   Brick field to add new bricks to.
+ *
+ * @param brick_grid
+ *   Spatial index to add new bricks to.
+ *
+ * @param y
+ *   Y coordinate of row.
+ *
+ * @param colour
+ *   Colour of bricks.
+ */
+void create_brick_row(cpp::BrickField &bricks, cpp::BrickGrid &brick_grid, float y, const cpp::Colour &colour)
+{
+    auto x = 20.0f;
+
+    for (auto i = 0u; i < 10u; ++i)
+    {
+        const cpp::Rectangle rectangle{{x, y}, 58.0f, 20.0f};
+        brick_grid.insert(bricks.add(rectangle, colour), rectangle);
+        x += brick_pitch_x;
+    }
+}
+
+/**
+ * Helper function to check for and resolve collisions between the ball and other entities.
+ *
+ * @param ball
+ *   Ball to check for collisions.
+ *
+ * @param ball_velocity
+ *   Velocity of ball, might get mutated during collision response.
+ *
+ * @param paddle
+ *   Paddle to check for collisions with.
+ *
+ * @param bricks
+ *   Collection of all bricks, a brick will be destroyed if a collision is detected.
+ *
+ * @param brick_grid
+ *   Spatial index of bricks, a brick will be removed if a collision is detected.
+ */
+void check_collisions(
+    const cpp::Entity &ball,
+    cpp::Vector2 &ball_velocity,
+    const cpp::Entity &paddle,
+    cpp::BrickField &bricks,
+    cpp::BrickGrid &brick_grid)
+{
+    // check and handle ball and paddle collision
+    if (paddle.intersects(ball))
+    {
+        const auto ball_pos = ball.rectangle().position;
+        const auto paddle_pos = paddle.rectangle().position;
+
+        if (ball_pos.x < paddle_pos.x + 100.0f)
+        {
+            ball_velocity.x = -0.7f;
+            ball_velocity.y = -0.7f;
+        }
+        else if (ball_pos.x < paddle_pos.x + 200.0f)
+        {
+            ball_velocity.x = 0.0f;
+            ball_velocity.y = -1.0f;
+        }
+        else
+        {
+            ball_velocity.x = 0.7f;
+            ball_velocity.y = -0.7f;
+        }
+    }
+    else
+    {
+        // only check brick intersections if we didn't intersect the paddle, unlikely these will both happen in the same
+        // frame due to the layout of the game
+
+        // only test the bricks in the grid cells the ball overlaps, the grid may hand us the same brick more than once
+        // (if it spans cells) so we track the lowest index hit, this matches the order of a linear scan
+        auto hit_brick = std::numeric_limits<std::size_t>::max();
+
+        brick_grid.query(ball.rectangle(), [&hit_brick](std::size_t i) { hit_brick = std::min(hit_brick, i); });
+
+        if (hit_brick != std::numeric_limits<std::size_t>::max())
+        {
+            // we hit a brick so update ball velocity and destroy the brick
+            ball_velocity.y *= -1.0f;
+            brick_grid.remove(hit_brick, bricks.rectangle(hit_brick));
+            bricks.destroy(hit_brick);
+        }
+    }
+}
+
+/**
+ * Helper function to update the ball. Will check if the ball leaves the window and adjust the velocity so it "bounces"
+ * off walls.
+ *
+ * @param ball
+ *   Ball entity to update.
+ *
+ * @param velocity
+ *   Ball velocity, will be mutated if ball goes off screen.
+ */
+void update_ball(cpp::Entity &ball, cpp::Vector2 &velocity)
+{
+    ball.translate(velocity);
+
+    const auto ball_pos = ball.rectangle().position;
+
+    if ((ball_pos.y > world_size) || (ball_pos.y < 0.0f))
+    {
+        velocity.y *= -1.0f;
+    }
+
+    if ((ball_pos.x > world_size) || (ball_pos.x < 0.0f))
+    {
+        velocity.x *= -1.0f;
+    }
+}
+
+/**
+ * Helper function to update the paddle.
+ *
+ * @param paddle
+ *   Paddle entity to update.
+ *
+ * @param velocity
+ *   Paddle velocity.
+ */
+void update_paddle(cpp::Entity &paddle, const cpp::Vector2 &velocity)
+{
+    paddle.translate(velocity);
+}
+
+}
+
+namespace cpp
+{
+
+Simulation::Simulation()
+    : paddle_({{300.0f, 780.0f}, 300.0f, 20.0f}, 0xFFFFFF)
+    , ball_({{420.0f, 400.0f}, 10.0f, 10.0f}, 0xFFFFFF)
+    , bricks_()
+    , brick_grid_(
+          brick_pitch_x,
+          brick_pitch_y,
+          static_cast<std::size_t>(world_size / brick_pitch_x) + 1u,
+          static_cast<std::size_t>(world_size / brick_pitch_y) + 1u)
+    , ball_velocity_(0.0f, 1.0f)
+    , paddle_velocity_(0.0f, 0.0f)
+{
+    create_brick_row(bricks_, brick_grid_, 50.0f, 0xff0000);
+    create_brick_row(bricks_, brick_grid_, 80.0f, 0xff0000);
+    create_brick_row(bricks_, brick_grid_, 110.0f, 0xffa500);
+    create_brick_row(bricks_, brick_grid_, 140.0f, 0xffa500);
+    create_brick_row(bricks_, brick_grid_, 170.0f, 0x00ff00);
+    create_brick_row(bricks_, brick_grid_, 200.0f, 0x00ff00);
+}
+
+void Simulation::step(const InputState &input)
+{
+    if (input.left == input.right)
+    {
+        paddle_velocity_.x = 0.0f;
+    }
+    else if (input.left)
+    {
+        paddle_velocity_.x = -paddle_speed;
+    }
+    else
+    {
+        paddle_velocity_.x = paddle_speed;
+    }
+
+    update_paddle(paddle_, paddle_velocity_);
+
+    {
+        const ScopedTimer timer{"update_ball"};
+        update_ball(ball_, ball_velocity_);
+    }
+
+    {
+        const ScopedTimer timer{"check_collisions"};
+        check_collisions(ball_, ball_velocity_, paddle_, bricks_, brick_grid_);
+    }
+
+    // bricks destroyed during this step were only marked as dead (so indices stayed stable), now we're done with them
+    // swap remove them, the cost of this is proportional to the number of hits not the number of bricks
+    bricks_.compact([this](std::size_t old_index, std::size_t new_index) {
+        brick_grid_.reindex(old_index, new_index, bricks_.rectangle(new_index));
+    });
+}
+
+const Entity &Simulation::paddle() const
+{
+    return paddle_;
+}
+
+const Entity &Simulation::ball() const
+{
+    return ball_;
+}
+
+const BrickField &Simulation::bricks() const
+{
+    return bricks_;
+}
+
+}
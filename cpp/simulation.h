@@ -0,0 +1,82 @@
+////////////////////////////////////////////////////////////////////////////////
+//         Distributed under the Boost Software License, Version 1.0.         //
+//            (See accompanying file LICENSE or copy at                       //
+//                 https://www.boost.org/LICENSE_1_0.txt)                     //
+////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include "brick_field.h"
+#include "brick_grid.h"
+#include "entity.h"
+#include "input_state.h"
+#include "vector2.h"
+
+namespace cpp
+{
+
+/**
+ * Simulation encapsulates all the game state and logic. It has no dependency on a window or any platform layer, so it
+ * can be stepped as fast as the host allows.
+ */
+class Simulation
+{
+  public:
+    /**
+     * Construct a new Simulation with the default level layout.
+     */
+    Simulation();
+
+    /**
+     * Advance the simulation by a single step.
+     *
+     * @param input
+     *   State of player inputs for this step.
+     */
+    void step(const InputState &input);
+
+    /**
+     * Get the paddle entity.
+     *
+     * @returns
+     *   Paddle entity.
+     */
+    const Entity &paddle() const;
+
+    /**
+     * Get the ball entity.
+     *
+     * @returns
+     *   Ball entity.
+     */
+    const Entity &ball() const;
+
+    /**
+     * Get all bricks in the simulation.
+     *
+     * @returns
+     *   Brick field.
+     */
+    const BrickField &bricks() const;
+
+  private:
+    /** Player controlled paddle. */
+    Entity paddle_;
+
+    /** Ball. */
+    Entity ball_;
+
+    /** All bricks. */
+    BrickField bricks_;
+
+    /** Spatial index of alive bricks. */
+    BrickGrid brick_grid_;
+
+    /** Current velocity of the ball. */
+    Vector2 ball_velocity_;
+
+    /** Current velocity of the paddle. */
+    Vector2 paddle_velocity_;
+};
+
+}
@@ -0,0 +1,157 @@
+////////////////////////////////////////////////////////////////////////////////
+//         Distributed under the Boost Software License, Version 1.0.         //
+//            (See accompanying file LICENSE or copy at                       //
+//                 https://www.boost.org/LICENSE_1_0.txt)                     //
+////////////////////////////////////////////////////////////////////////////////
+
+#include "software_renderer.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && (_M_IX86_FP >= 2))
+#define CPP_SIM_SSE2
+#include <emmintrin.h>
+#endif
+
+#include "brick_field.h"
+#include "colour.h"
+#include "entity.h"
+
+namespace
+{
+
+/** Opaque black in framebuffer format. */
+constexpr auto clear_pixel = std::uint32_t{0x000000ffu};
+
+/**
+ * Helper function to convert a colour to framebuffer format.
+ *
+ * @param colour
+ *   Colour to convert.
+ *
+ * @returns
+ *   Opaque pixel value.
+ */
+std::uint32_t to_pixel(const cpp::Colour &colour)
+{
+    return (static_cast<std::uint32_t>(colour.r) << 24u) | (static_cast<std::uint32_t>(colour.g) << 16u) |
+           (static_cast<std::uint32_t>(colour.b) << 8u) | 0xffu;
+}
+
+/**
+ * Helper function to fill a contiguous span of pixels with a single value, using the widest stores available.
+ *
+ * @param pixels
+ *   Address of first pixel to fill.
+ *
+ * @param count
+ *   Number of pixels to fill.
+ *
+ * @param value
+ *   Pixel value to write.
+ */
+void fill_span(std::uint32_t *pixels, std::size_t count, std::uint32_t value)
+{
+    auto i = std::size_t{0u};
+
+#if defined(__AVX2__)
+    const auto wide_value = _mm256_set1_epi32(static_cast<int>(value));
+
+    for (; i + 8u <= count; i += 8u)
+    {
+        _mm256_storeu_si256(reinterpret_cast<__m256i *>(pixels + i), wide_value);
+    }
+#elif defined(CPP_SIM_SSE2)
+    const auto wide_value = _mm_set1_epi32(static_cast<int>(value));
+
+    for (; i + 4u <= count; i += 4u)
+    {
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(pixels + i), wide_value);
+    }
+#endif
+
+    // scalar tail (or the whole span if there are no vector stores)
+    for (; i < count; ++i)
+    {
+        pixels[i] = value;
+    }
+}
+
+}
+
+namespace cpp
+{
+
+SoftwareRenderer::SoftwareRenderer()
+    : framebuffer_(width * height, clear_pixel)
+{
+}
+
+void SoftwareRenderer::render(std::span<const Entity> entities, const BrickField &bricks)
+{
+    fill_span(framebuffer_.data(), framebuffer_.size(), clear_pixel);
+
+    for (const auto &entity : entities)
+    {
+        const auto entity_rect = entity.rectangle();
+
+        fill_rectangle(
+            entity_rect.position.x, entity_rect.position.y, entity_rect.width, entity_rect.height, entity.colour());
+    }
+
+    const auto xs = bricks.x();
+    const auto ys = bricks.y();
+    const auto widths = bricks.width();
+    const auto heights = bricks.height();
+    const auto colours = bricks.colour();
+    const auto alive = bricks.alive_mask();
+
+    for (auto i = std::size_t{0u}; i < bricks.size(); ++i)
+    {
+        if (alive[i] != 0u)
+        {
+            fill_rectangle(xs[i], ys[i], widths[i], heights[i], colours[i]);
+        }
+    }
+}
+
+std::span<const std::uint32_t> SoftwareRenderer::framebuffer() const
+{
+    return framebuffer_;
+}
+
+void SoftwareRenderer::fill_rectangle(float x, float y, float rect_width, float rect_height, const Colour &colour)
+{
+    // truncate to whole pixels in the same way as the SDL renderer, then clip to the framebuffer
+    const auto left = static_cast<std::ptrdiff_t>(static_cast<int>(x));
+    const auto top = static_cast<std::ptrdiff_t>(static_cast<int>(y));
+    const auto right = left + static_cast<std::ptrdiff_t>(static_cast<int>(rect_width));
+    const auto bottom = top + static_cast<std::ptrdiff_t>(static_cast<int>(rect_height));
+
+    const auto clip_left = std::clamp(left, std::ptrdiff_t{0}, static_cast<std::ptrdiff_t>(width));
+    const auto clip_right = std::clamp(right, std::ptrdiff_t{0}, static_cast<std::ptrdiff_t>(width));
+    const auto clip_top = std::clamp(top, std::ptrdiff_t{0}, static_cast<std::ptrdiff_t>(height));
+    const auto clip_bottom = std::clamp(bottom, std::ptrdiff_t{0}, static_cast<std::ptrdiff_t>(height));
+
+    if ((clip_left >= clip_right) || (clip_top >= clip_bottom))
+    {
+        return;
+    }
+
+    const auto pixel = to_pixel(colour);
+    const auto span_width = static_cast<std::size_t>(clip_right - clip_left);
+    auto *row_start = framebuffer_.data() + (static_cast<std::size_t>(clip_top) * width) + clip_left;
+
+    for (auto row = clip_top; row < clip_bottom; ++row)
+    {
+        fill_span(row_start, span_width, pixel);
+        row_start += width;
+    }
+}
+
+}
@@ -0,0 +1,85 @@
+////////////////////////////////////////////////////////////////////////////////
+//         Distributed under the Boost Software License, Version 1.0.         //
+//            (See accompanying file LICENSE or copy at                       //
+//                 https://www.boost.org/LICENSE_1_0.txt)                     //
+////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include "brick_field.h"
+#include "colour.h"
+#include "entity.h"
+
+namespace cpp
+{
+
+/**
+ * SoftwareRenderer rasterises entities into a CPU side framebuffer. It has no dependency on a window or a GPU, so can
+ * be used to produce frames on headless machines.
+ *
+ * Pixels are stored as 32 bit values in 0xRRGGBBAA format (SDL_PIXELFORMAT_RGBA8888), row major with no padding.
+ */
+class SoftwareRenderer
+{
+  public:
+    /** Width of framebuffer in pixels. */
+    static constexpr std::size_t width = 800u;
+
+    /** Height of framebuffer in pixels. */
+    static constexpr std::size_t height = 800u;
+
+    /**
+     * Construct a new SoftwareRenderer, with a black framebuffer.
+     */
+    SoftwareRenderer();
+
+    /**
+     * Render a collection of entities and a brick field. The framebuffer is cleared to black first.
+     *
+     * @param entities
+     *   Entities to render.
+     *
+     * @param bricks
+     *   Bricks to render, dead bricks are skipped.
+     */
+    void render(std::span<const Entity> entities, const BrickField &bricks);
+
+    /**
+     * Get the framebuffer contents.
+     *
+     * @returns
+     *   Framebuffer pixels, width * height in row major order.
+     */
+    std::span<const std::uint32_t> framebuffer() const;
+
+  private:
+    /**
+     * Fill a rectangle, clipped to the framebuffer. Coordinates are truncated to whole pixels.
+     *
+     * @param x
+     *   X coordinate of upper left corner.
+     *
+     * @param y
+     *   Y coordinate of upper left corner.
+     *
+     * @param rect_width
+     *   Width of rectangle.
+     *
+     * @param rect_height
+     *   Height of rectangle.
+     *
+     * @param colour
+     *   Colour of rectangle.
+     */
+    void fill_rectangle(float x, float y, float rect_width, float rect_height, const Colour &colour);
+
+    /** Framebuffer pixels. */
+    std::vector<std::uint32_t> framebuffer_;
+};
+
+}
@@ -6,15 +6,23 @@
 
 #include "window.h"
 
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
 #include <memory>
 #include <optional>
+#include <span>
 #include <stdexcept>
 #include <vector>
 
 #include "SDL.h"
 
+#include "brick_field.h"
+#include "colour.h"
 #include "entity.h"
 #include "key_event.h"
+#include "software_renderer.h"
 
 namespace
 {
@@ -37,18 +45,104 @@ std::optional<cpp::Key> map_sdl_key(SDL_Keycode sdl_code)
         case SDLK_ESCAPE: return ESCAPE;
         case SDLK_LEFT: return LEFT;
         case SDLK_RIGHT: return RIGHT;
+        case SDLK_F12: return F12;
         default: return std::nullopt;
     }
 }
 
+/**
+ * Helper function to map an SDL event to an internal key event.
+ *
+ * @param sdl_event
+ *   SDL event.
+ *
+ * @returns
+ *   Internal representation of the supplied event, or empty optional if it isn't a mapped key event.
+ */
+std::optional<cpp::KeyEvent> map_sdl_event(const SDL_Event &sdl_event)
+{
+    std::optional<cpp::KeyState> key_state;
+
+    if (sdl_event.type == SDL_KEYDOWN)
+    {
+        key_state = cpp::KeyState::DOWN;
+    }
+    else if (sdl_event.type == SDL_KEYUP)
+    {
+        key_state = cpp::KeyState::UP;
+    }
+
+    // if we got a key state then it's safe to inspect the key code
+    if (key_state)
+    {
+        if (const auto key = map_sdl_key(sdl_event.key.keysym.sym); key)
+        {
+            // got state and key - so create the KeyEvent
+            return cpp::KeyEvent{.key_state = *key_state, .key = *key};
+        }
+    }
+
+    return std::nullopt;
+}
+
+/**
+ * Helper function to append a filled rectangle to a vertex buffer. Coordinates are truncated to whole pixels.
+ *
+ * @param vertices
+ *   Vertex buffer to append four vertices to.
+ *
+ * @param x
+ *   X coordinate of upper left corner.
+ *
+ * @param y
+ *   Y coordinate of upper left corner.
+ *
+ * @param width
+ *   Width of rectangle.
+ *
+ * @param height
+ *   Height of rectangle.
+ *
+ * @param colour
+ *   Colour of rectangle.
+ */
+void push_rectangle(
+    std::vector<SDL_Vertex> &vertices,
+    float x,
+    float y,
+    float width,
+    float height,
+    const cpp::Colour &colour)
+{
+    const auto left = static_cast<float>(static_cast<int>(x));
+    const auto top = static_cast<float>(static_cast<int>(y));
+    const auto right = left + static_cast<float>(static_cast<int>(width));
+    const auto bottom = top + static_cast<float>(static_cast<int>(height));
+    const SDL_Color sdl_colour = {.r = colour.r, .g = colour.g, .b = colour.b, .a = 0xff};
+
+    vertices.push_back({.position = {left, top}, .color = sdl_colour, .tex_coord = {}});
+    vertices.push_back({.position = {right, top}, .color = sdl_colour, .tex_coord = {}});
+    vertices.push_back({.position = {right, bottom}, .color = sdl_colour, .tex_coord = {}});
+    vertices.push_back({.position = {left, bottom}, .color = sdl_colour, .tex_coord = {}});
+}
+
 }
 
 namespace cpp
 {
 
 Window::Window()
+    : Window(RenderBackend::HARDWARE)
+{
+}
+
+Window::Window(RenderBackend backend)
     : window_(nullptr, &SDL_DestroyWindow)
     , renderer_(nullptr, &SDL_DestroyRenderer)
+    , vertices_()
+    , indices_()
+    , software_renderer_()
+    , texture_(nullptr, &SDL_DestroyTexture)
 {
     if (::SDL_Init(SDL_INIT_VIDEO) != 0)
     {
@@ -67,8 +161,30 @@ Window::Window()
     {
         throw std::runtime_error("failed to create renderer");
     }
+
+    if (backend == RenderBackend::SOFTWARE)
+    {
+        software_renderer_.emplace();
+
+        texture_.reset(::SDL_CreateTexture(
+            renderer_.get(),
+            SDL_PIXELFORMAT_RGBA8888,
+            SDL_TEXTUREACCESS_STREAMING,
+            static_cast<int>(SoftwareRenderer::width),
+            static_cast<int>(SoftwareRenderer::height)));
+        if (!texture_)
+        {
+            throw std::runtime_error("failed to create texture");
+        }
+    }
 }
 
+Window::~Window() = default;
+
+Window::Window(Window &&) = default;
+
+Window &Window::operator=(Window &&) = default;
+
 std::optional<KeyEvent> Window::get_event() const
 {
     std::optional<KeyEvent> event{};
@@ -76,33 +192,79 @@ std::optional<KeyEvent> Window::get_event() const
     SDL_Event sdl_event = {0};
     if (::SDL_PollEvent(&sdl_event) != 0u)
     {
-        std::optional<KeyState> key_state;
+        event = map_sdl_event(sdl_event);
+    }
 
-        if (sdl_event.type == SDL_KEYDOWN)
-        {
-            key_state = KeyState::DOWN;
-        }
-        else if (sdl_event.type == SDL_KEYUP)
+    return event;
+}
+
+EventPollResult Window::poll_events(std::span<KeyEvent> events) const
+{
+    EventPollResult result{.count = 0u, .dropped = 0u};
+
+    // SDL_PeepEvents doesn't pump the event loop itself
+    ::SDL_PumpEvents();
+
+    // staging buffer for raw SDL events, we never request more than the space left in the caller buffer so no key
+    // events are lost when it fills up
+    std::array<SDL_Event, 64u> sdl_events;
+
+    while (result.count < events.size())
+    {
+        const auto request = std::min(sdl_events.size(), events.size() - result.count);
+        const auto received = ::SDL_PeepEvents(
+            sdl_events.data(), static_cast<int>(request), SDL_GETEVENT, SDL_FIRSTEVENT, SDL_LASTEVENT);
+        if (received < 0)
         {
-            key_state = KeyState::UP;
+            throw std::runtime_error("failed to peep events");
         }
 
-        // if we got a key state then it's safe to inspect the key code
-        if (key_state)
+        for (const auto &sdl_event : std::span{sdl_events}.first(static_cast<std::size_t>(received)))
         {
-            if (const auto key = map_sdl_key(sdl_event.key.keysym.sym); key)
+            if (const auto event = map_sdl_event(sdl_event); event)
+            {
+                events[result.count++] = *event;
+            }
+            else
             {
-                // got state and key - so create the KeyEvent
-                event = KeyEvent{.key_state = *key_state, .key = *key};
+                ++result.dropped;
             }
         }
+
+        // a short read means the queue is empty
+        if (static_cast<std::size_t>(received) < request)
+        {
+            break;
+        }
     }
 
-    return event;
+    return result;
 }
 
-void Window::render(const std::vector<Entity> &entities) const
+void Window::render(std::span<const Entity> entities, const BrickField &bricks) const
 {
+    if (software_renderer_)
+    {
+        software_renderer_->render(entities, bricks);
+
+        if (::SDL_UpdateTexture(
+                texture_.get(),
+                nullptr,
+                software_renderer_->framebuffer().data(),
+                static_cast<int>(SoftwareRenderer::width * sizeof(std::uint32_t))) != 0)
+        {
+            throw std::runtime_error("failed to update texture");
+        }
+
+        if (::SDL_RenderCopy(renderer_.get(), texture_.get(), nullptr, nullptr) != 0)
+        {
+            throw std::runtime_error("failed to copy texture");
+        }
+
+        ::SDL_RenderPresent(renderer_.get());
+        return;
+    }
+
     if (::SDL_SetRenderDrawColor(renderer_.get(), 0x0, 0x0, 0x0, 0xff) != 0)
     {
         throw std::runtime_error("failed to set render draw colour");
@@ -113,30 +275,65 @@ void Window::render(const std::vector<Entity> &entities) const
         throw std::runtime_error("failed to clear renderer");
     }
 
+    vertices_.clear();
+
     for (const auto &entity : entities)
     {
         const auto entity_rect = entity.rectangle();
-        const auto entity_colour = entity.colour();
 
-        const SDL_Rect sdl_rect = {
-            .x = static_cast<int>(entity_rect.position.x),
-            .y = static_cast<int>(entity_rect.position.y),
-            .w = static_cast<int>(entity_rect.width),
-            .h = static_cast<int>(entity_rect.height),
-        };
+        push_rectangle(
+            vertices_,
+            entity_rect.position.x,
+            entity_rect.position.y,
+            entity_rect.width,
+            entity_rect.height,
+            entity.colour());
+    }
+
+    const auto xs = bricks.x();
+    const auto ys = bricks.y();
+    const auto widths = bricks.width();
+    const auto heights = bricks.height();
+    const auto colours = bricks.colour();
+    const auto alive = bricks.alive_mask();
 
-        if (::SDL_SetRenderDrawColor(renderer_.get(), entity_colour.r, entity_colour.g, entity_colour.b, 0xff) != 0)
+    for (auto i = std::size_t{0u}; i < bricks.size(); ++i)
+    {
+        if (alive[i] != 0u)
         {
-            throw std::runtime_error("failed to draw entity");
+            push_rectangle(vertices_, xs[i], ys[i], widths[i], heights[i], colours[i]);
         }
+    }
+
+    const auto quad_count = vertices_.size() / 4u;
+
+    // extend the index buffer if we have more quads than ever before
+    for (auto quad = indices_.size() / 6u; quad < quad_count; ++quad)
+    {
+        const auto base = static_cast<int>(quad * 4u);
+        indices_.insert(indices_.end(), {base, base + 1, base + 2, base + 2, base + 3, base});
+    }
 
-        if (::SDL_RenderFillRect(renderer_.get(), &sdl_rect) != 0)
+    if (quad_count != 0u)
+    {
+        if (::SDL_RenderGeometry(
+                renderer_.get(),
+                nullptr,
+                vertices_.data(),
+                static_cast<int>(vertices_.size()),
+                indices_.data(),
+                static_cast<int>(quad_count * 6u)) != 0)
         {
-            throw std::runtime_error("failed to draw filled rect");
+            throw std::runtime_error("failed to render geometry");
         }
     }
 
     ::SDL_RenderPresent(renderer_.get());
 }
 
+std::span<const std::uint32_t> Window::framebuffer() const
+{
+    return software_renderer_ ? software_renderer_->framebuffer() : std::span<const std::uint32_t>{};
+}
+
 }
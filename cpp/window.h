@@ -6,22 +6,54 @@
 
 #pragma once
 
+#include <cstddef>
+#include <cstdint>
 #include <memory>
 #include <optional>
+#include <span>
 #include <vector>
 
+#include "brick_field.h"
 #include "entity.h"
 #include "key_event.h"
+#include "software_renderer.h"
 
 struct SDL_Window;
 struct SDL_Renderer;
+struct SDL_Texture;
+struct SDL_Vertex;
 
 using SDLWindowDelete = void (*)(SDL_Window *);
 using SDLRendererDelete = void (*)(SDL_Renderer *);
+using SDLTextureDelete = void (*)(SDL_Texture *);
 
 namespace cpp
 {
 
+/**
+ * Enumeration of possible render backends.
+ */
+enum class RenderBackend
+{
+    /** Draw with the SDL renderer. */
+    HARDWARE,
+
+    /** Rasterise into a CPU side framebuffer with SoftwareRenderer, then upload it to the window. */
+    SOFTWARE
+};
+
+/**
+ * Struct encapsulating the result of draining the event queue.
+ */
+struct EventPollResult
+{
+    /** Number of key events written to the caller supplied buffer. */
+    std::size_t count;
+
+    /** Number of events removed from the queue that were not key events or had no key mapping. */
+    std::size_t dropped;
+};
+
 /**
  * Window is responsible for creating and destroying a platform window as well as rendering to it and getting events.
  */
@@ -29,15 +61,26 @@ class Window
 {
   public:
     /**
-     * Construct a new Window.
+     * Construct a new Window, using the hardware render backend.
      */
     Window();
 
+    /**
+     * Construct a new Window.
+     *
+     * @param backend
+     *   Backend to render with.
+     */
+    explicit Window(RenderBackend backend);
+
+    // these are defined in the source file as SDL_Vertex is incomplete here
+    ~Window();
+
     Window(const Window &) = delete;
     Window &operator=(const Window &) = delete;
 
-    Window(Window &&) = default;
-    Window &operator=(Window &&) = default;
+    Window(Window &&);
+    Window &operator=(Window &&);
 
     /**
      * Get an event if one is available.
@@ -48,12 +91,39 @@ class Window
     std::optional<KeyEvent> get_event() const;
 
     /**
-     * Render a collection of entities.
+     * Drain pending events into a caller supplied buffer, without allocating. Events are removed from the queue until
+     * either the queue is empty or the buffer is full, in which case remaining events are left for the next call.
+     *
+     * @param events
+     *   Buffer to write key events to.
+     *
+     * @returns
+     *   Number of key events written and number of events dropped.
+     */
+    EventPollResult poll_events(std::span<KeyEvent> events) const;
+
+    /**
+     * Render a collection of entities and a brick field.
+     *
+     * With the hardware backend all rectangles are converted into a single vertex/index buffer and submitted with one
+     * draw call. With the software backend they are rasterised into the framebuffer, which is then uploaded through a
+     * streaming texture.
      *
      * @param entities
      *   Entities to render.
+     *
+     * @param bricks
+     *   Bricks to render, dead bricks are skipped.
      */
-    void render(const std::vector<Entity> &entities) const;
+    void render(std::span<const Entity> entities, const BrickField &bricks) const;
+
+    /**
+     * Get the contents of the software framebuffer, as of the last call to render.
+     *
+     * @returns
+     *   Framebuffer pixels (see SoftwareRenderer for format), or an empty span if not using the software backend.
+     */
+    std::span<const std::uint32_t> framebuffer() const;
 
   private:
     /** SDL window object. */
@@ -61,6 +131,18 @@ class Window
 
     /** SDL renderer object. */
     std::unique_ptr<SDL_Renderer, SDLRendererDelete> renderer_;
+
+    /** Vertex buffer, reused across frames so it only allocates when it needs to grow. */
+    mutable std::vector<SDL_Vertex> vertices_;
+
+    /** Index buffer, two triangles per rectangle. Only ever grows as the indices for a given quad never change. */
+    mutable std::vector<int> indices_;
+
+    /** Rasteriser for the software backend, empty if using the hardware backend. */
+    mutable std::optional<SoftwareRenderer> software_renderer_;
+
+    /** Streaming texture the software framebuffer is uploaded through, null if using the hardware backend. */
+    std::unique_ptr<SDL_Texture, SDLTextureDelete> texture_;
 };
 
 }
@@ -0,0 +1,197 @@
+////////////////////////////////////////////////////////////////////////////////
+//         Distributed under the Boost Software License, Version 1.0.         //
+//            (See accompanying file LICENSE or copy at                       //
+//                 https://www.boost.org/LICENSE_1_0.txt)                     //
+////////////////////////////////////////////////////////////////////////////////
+
+#include "work_stealing_pool.h"
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+namespace cpp
+{
+
+WorkStealingPool::WorkStealingPool(std::size_t thread_count)
+    : ranges_(std::make_unique<Range[]>(thread_count))
+    , worker_count_(thread_count)
+    , threads_()
+    , mutex_()
+    , start_condition_()
+    , done_condition_()
+    , task_(nullptr)
+    , generation_(0u)
+    , busy_threads_(0u)
+    , stopping_(false)
+{
+    assert(thread_count > 0u);
+
+    // the thread calling parallel_for is worker 0, so we only need threads for the rest
+    threads_.reserve(worker_count_ - 1u);
+    for (auto worker = std::size_t{1u}; worker < worker_count_; ++worker)
+    {
+        threads_.emplace_back([this, worker] { worker_loop(worker); });
+    }
+}
+
+WorkStealingPool::~WorkStealingPool()
+{
+    {
+        const std::scoped_lock lock{mutex_};
+        stopping_ = true;
+    }
+
+    start_condition_.notify_all();
+
+    for (auto &thread : threads_)
+    {
+        thread.join();
+    }
+}
+
+std::size_t WorkStealingPool::thread_count() const
+{
+    return worker_count_;
+}
+
+void WorkStealingPool::parallel_for(std::size_t count, const std::function<void(std::size_t)> &task)
+{
+    // split the indices evenly, with any remainder going to the first workers
+    const auto share = count / worker_count_;
+    const auto remainder = count % worker_count_;
+    auto begin = std::size_t{0u};
+
+    for (auto worker = std::size_t{0u}; worker < worker_count_; ++worker)
+    {
+        const auto end = begin + share + ((worker < remainder) ? 1u : 0u);
+
+        const std::scoped_lock lock{ranges_[worker].mutex};
+        ranges_[worker].begin = begin;
+        ranges_[worker].end = end;
+
+        begin = end;
+    }
+
+    // wake the pool threads
+    {
+        const std::scoped_lock lock{mutex_};
+        task_ = &task;
+        busy_threads_ = threads_.size();
+        ++generation_;
+    }
+
+    start_condition_.notify_all();
+
+    run_tasks(0u);
+
+    // every index has been claimed, but pool threads may still be running their last task (which references task)
+    std::unique_lock lock{mutex_};
+    done_condition_.wait(lock, [this] { return busy_threads_ == 0u; });
+    task_ = nullptr;
+}
+
+void WorkStealingPool::worker_loop(std::size_t worker)
+{
+    auto seen_generation = std::uint64_t{0u};
+
+    for (;;)
+    {
+        {
+            std::unique_lock lock{mutex_};
+            start_condition_.wait(lock, [this, seen_generation] {
+                return stopping_ || (generation_ != seen_generation);
+            });
+
+            if (stopping_)
+            {
+                return;
+            }
+
+            seen_generation = generation_;
+        }
+
+        run_tasks(worker);
+
+        {
+            const std::scoped_lock lock{mutex_};
+            --busy_threads_;
+        }
+
+        done_condition_.notify_one();
+    }
+}
+
+void WorkStealingPool::run_tasks(std::size_t worker)
+{
+    const auto &task = *task_;
+    auto index = std::size_t{0u};
+
+    for (;;)
+    {
+        while (pop(worker, index))
+        {
+            task(index);
+        }
+
+        if (!steal(worker))
+        {
+            return;
+        }
+    }
+}
+
+bool WorkStealingPool::pop(std::size_t worker, std::size_t &index)
+{
+    auto &range = ranges_[worker];
+    const std::scoped_lock lock{range.mutex};
+
+    if (range.begin == range.end)
+    {
+        return false;
+    }
+
+    index = range.begin++;
+    return true;
+}
+
+bool WorkStealingPool::steal(std::size_t worker)
+{
+    // start with the next worker along, so thieves spread out rather than all hitting worker 0
+    for (auto offset = std::size_t{1u}; offset < worker_count_; ++offset)
+    {
+        auto &victim = ranges_[(worker + offset) % worker_count_];
+        auto begin = std::size_t{0u};
+        auto end = std::size_t{0u};
+
+        {
+            const std::scoped_lock lock{victim.mutex};
+
+            if (victim.begin == victim.end)
+            {
+                continue;
+            }
+
+            // take the back half (rounding up, so a single index can be stolen), the victim carries on from the front
+            begin = victim.begin + ((victim.end - victim.begin) / 2u);
+            end = victim.end;
+            victim.end = begin;
+        }
+
+        // our range is empty so nobody else can take from it whilst we weren't holding its lock
+        auto &range = ranges_[worker];
+        const std::scoped_lock lock{range.mutex};
+        range.begin = begin;
+        range.end = end;
+
+        return true;
+    }
+
+    return false;
+}
+
+}
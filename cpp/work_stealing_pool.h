@@ -0,0 +1,156 @@
+////////////////////////////////////////////////////////////////////////////////
+//         Distributed under the Boost Software License, Version 1.0.         //
+//            (See accompanying file LICENSE or copy at                       //
+//                 https://www.boost.org/LICENSE_1_0.txt)                     //
+////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace cpp
+{
+
+/**
+ * WorkStealingPool runs a task over a range of indices on a fixed set of threads.
+ *
+ * Each thread starts with an even share of the range. A thread which finishes its share steals the back half of the
+ * remaining indices from another thread, so uneven tasks still keep every thread busy. Indices are handed out under a
+ * per thread lock which is only contended when stealing.
+ */
+class WorkStealingPool
+{
+  public:
+    /**
+     * Construct a new WorkStealingPool.
+     *
+     * @param thread_count
+     *   Number of threads to run tasks on, including the thread calling parallel_for. Must be at least 1.
+     */
+    explicit WorkStealingPool(std::size_t thread_count);
+
+    /**
+     * Stop and join all threads.
+     */
+    ~WorkStealingPool();
+
+    WorkStealingPool(const WorkStealingPool &) = delete;
+    WorkStealingPool &operator=(const WorkStealingPool &) = delete;
+
+    /**
+     * Get the number of threads tasks are run on.
+     *
+     * @returns
+     *   Thread count, including the calling thread.
+     */
+    std::size_t thread_count() const;
+
+    /**
+     * Run a task for every index in [0, count), blocking until they have all completed. The calling thread also runs
+     * tasks.
+     *
+     * @param count
+     *   Number of indices.
+     *
+     * @param task
+     *   Task to run, it must not throw and may be called concurrently (with different indices).
+     */
+    void parallel_for(std::size_t count, const std::function<void(std::size_t)> &task);
+
+  private:
+    /**
+     * Range of indices yet to be run by a single thread. Padded to a cache line so threads don't contend on each
+     * other's ranges.
+     */
+    struct alignas(64) Range
+    {
+        /** Guards begin and end. */
+        std::mutex mutex;
+
+        /** First index yet to be run. */
+        std::size_t begin = 0u;
+
+        /** One past the last index yet to be run. */
+        std::size_t end = 0u;
+    };
+
+    /**
+     * Entry point for pool threads.
+     *
+     * @param worker
+     *   Index of worker.
+     */
+    void worker_loop(std::size_t worker);
+
+    /**
+     * Run tasks until there are no indices left to run or steal.
+     *
+     * @param worker
+     *   Index of worker.
+     */
+    void run_tasks(std::size_t worker);
+
+    /**
+     * Take the next index from a worker's own range.
+     *
+     * @param worker
+     *   Index of worker.
+     *
+     * @param index
+     *   Out parameter for index to run.
+     *
+     * @returns
+     *   True if an index was taken, false if the range was empty.
+     */
+    bool pop(std::size_t worker, std::size_t &index);
+
+    /**
+     * Steal the back half of another worker's range into a worker's own (empty) range.
+     *
+     * @param worker
+     *   Index of stealing worker.
+     *
+     * @returns
+     *   True if anything was stolen, false if every other range was empty.
+     */
+    bool steal(std::size_t worker);
+
+    /** Per worker ranges, worker 0 is the thread calling parallel_for. */
+    std::unique_ptr<Range[]> ranges_;
+
+    /** Number of workers (and ranges). */
+    std::size_t worker_count_;
+
+    /** Pool threads, one per worker other than worker 0. */
+    std::vector<std::thread> threads_;
+
+    /** Guards everything below. */
+    std::mutex mutex_;
+
+    /** Signalled when a new batch starts or the pool is stopping. */
+    std::condition_variable start_condition_;
+
+    /** Signalled when a pool thread finishes its part of a batch. */
+    std::condition_variable done_condition_;
+
+    /** Task for the current batch. */
+    const std::function<void(std::size_t)> *task_;
+
+    /** Incremented for each batch, so threads can tell a new batch from a spurious wakeup. */
+    std::uint64_t generation_;
+
+    /** Number of pool threads still running the current batch. */
+    std::size_t busy_threads_;
+
+    /** True when the pool is being destroyed. */
+    bool stopping_;
+};
+
+}